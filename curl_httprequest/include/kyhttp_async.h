@@ -0,0 +1,954 @@
+/*!**********************************************************************
+* @copyright Copyright (C) 2022 thuong.nv -email: mark.ngo@kohyoung.com.\n
+*            All rights reserved.
+*************************************************************************
+* @file     kyhttp_async.h
+* @date     Oct 17, 2026
+* @brief    HTTP client libcurl implementation file.
+*
+** Asynchronous HTTP client : many transfers on one curl_multi driver thread
+*************************************************************************/
+#pragma once
+
+#include <map>
+#include <set>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <future>
+#include <functional>
+#include <curl/multi.h>
+
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+#define KYHTTP_COROUTINE
+#endif // __cpp_impl_coroutine
+
+#include "kyhttp_curl.h"
+#include "kyhttp_eventloop.h"
+
+__BEGIN_NAMESPACE__
+
+class AsyncHttpClient;
+typedef std::shared_ptr<AsyncHttpClient> AsyncHttpClientPtr;
+
+typedef std::function<void(HttpErrorCode, HttpResponsePtr)> HttpCompletionFunc;
+
+/*==================================================================================
+* Class AsyncHttpClient
+* Owns one curl_multi handle and a single driver thread (curl_multi_poll).
+* Every transfer uses its own HttpClient for the easy handle setup, so option,
+* ssl, proxy, cookie and redirect behave the same as the blocking client.
+*
+* AsyncHttpClient(HttpEventLoopPtr) uses curl_multi_socket_action on the event
+* loop instead of curl_multi_poll (Linux epoll : cost per wakeup = ready sockets).
+* The loop is run by the user (own reactor) or by the client (run_loop_thread).
+*
+* Note: request (and its content) must stay alive until the transfer completes
+*		 one HttpRequest object for one in-flight transfer
+*		 completion callback runs on the driver thread -> do not block inside
+*		 event loop mode : Stop / destroy on the loop thread or when loop stopped
+*						   (run_loop_thread : any thread)
+*
+* C++20 : co_await client->GetAsync(uri) / PostAsync(uri, request) -> HttpResponsePtr
+*		  needs /std:c++20 (set in curl_httprequest.vcxproj) : not declared before C++20
+*		  the coroutine is resumed inside the completion callback (driver / loop thread)
+===================================================================================*/
+class AsyncHttpClient
+{
+protected:
+	struct HttpTransfer
+	{
+		HttpClientPtr					m_client;
+		HttpRequestPtr					m_request;
+		HttpMethod						m_method;
+		Uri								m_uri;
+
+		HttpCompletionFunc				m_callback;
+
+		// hedged GET : primary and duplicate, callback once for the pair
+		HttpHedgePolicyPtr				m_hedge_policy;	// nullptr : no hedge
+		std::weak_ptr<HttpTransfer>		m_sibling;
+		std::shared_ptr<BOOL>			m_completed;
+		BOOL							m_is_hedge;
+		std::chrono::steady_clock::time_point m_start_time;
+
+		HttpTransfer() : m_method(HttpMethod::GET), m_is_hedge(FALSE) {}
+	};
+	typedef std::shared_ptr<HttpTransfer> HttpTransferPtr;
+	typedef std::weak_ptr<HttpTransfer>	  HttpTransferWPtr;
+
+private:
+	CURLM*								m_multi;
+	std::thread							m_driver;
+	std::atomic<bool>					m_running;
+
+	std::mutex							m_pending_lock;	// pending, settings below, running / multi for submitter
+	std::vector<HttpTransferPtr>		m_pending;		// submitted, not added to multi yet
+	BOOL								m_multi_option_changed; // Configunation : limits applied by driver thread
+	std::map<CURL*, HttpTransferPtr>	m_transfers;	// in-flight : driver thread only
+	std::multimap<std::chrono::steady_clock::time_point, HttpTransferPtr> m_delayed; // retry waiting for delay : driver thread only
+	std::multimap<std::chrono::steady_clock::time_point, HttpTransferWPtr> m_hedge_checks; // first byte deadline : driver thread only
+
+	HttpClientOption					m_option;
+	SSLSetting							m_ssl_setting;
+	WebProxy							m_proxy;
+	HttpSharePoolPtr					m_share_pool;
+	HttpRetryPolicyPtr					m_retry_policy;
+	HttpHedgePolicyPtr					m_hedge_policy;
+	HttpCircuitBreakerPtr				m_circuit_breaker;
+	HttpBandwidthGovernorPtr			m_bandwidth_governor;
+	BOOL								m_bandwidth_used;	// transfer with governor started : driver thread only
+
+	HttpEventLoopPtr					m_loop;				// nullptr : curl_multi_poll driver thread
+	uint64_t							m_curl_timer;
+	uint64_t							m_bandwidth_timer;	// resume paused transfer
+	std::set<curl_socket_t>				m_sockets;			// watched by loop
+	std::shared_ptr<std::atomic<bool>>	m_alive;			// posted tasks / timers outlive client
+
+public:
+	AsyncHttpClient() : m_multi(NULL),
+		m_running(false),
+		m_multi_option_changed(FALSE),
+		m_share_pool(nullptr),
+		m_bandwidth_used(FALSE),
+		m_loop(nullptr),
+		m_curl_timer(0),
+		m_bandwidth_timer(0)
+	{
+		m_multi = curl_multi_init();
+
+		if (!m_multi)
+		{
+			KY_HTTP_LOG_ERROR(L"[err] : init curl_multi failed !");
+			return;
+		}
+
+		// HTTP/2 : concurrent transfers same origin share one connection
+		curl_multi_setopt(m_multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+		this->ApplyMultiOption(m_option);
+
+		m_running = true;
+		m_driver  = std::thread(&AsyncHttpClient::DriverLoop, this);
+	}
+
+	/******************************************************************************
+	*! @brief  : event loop mode : curl_multi_socket_action driven by loop
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	loop : run by user (Run / RunOnce) on one thread
+	*! @parameter:	run_loop_thread : TRUE : client runs the loop on own thread
+	******************************************************************************/
+	explicit AsyncHttpClient(HttpEventLoopPtr loop, BOOL run_loop_thread = FALSE) : m_multi(NULL),
+		m_running(false),
+		m_multi_option_changed(FALSE),
+		m_share_pool(nullptr),
+		m_bandwidth_used(FALSE),
+		m_loop(loop),
+		m_curl_timer(0),
+		m_bandwidth_timer(0),
+		m_alive(std::make_shared<std::atomic<bool>>(true))
+	{
+		m_multi = curl_multi_init();
+
+		if (!m_multi || !m_loop)
+		{
+			KY_HTTP_LOG_ERROR(L"[err] : init curl_multi failed !");
+			return;
+		}
+
+		curl_multi_setopt(m_multi, CURLMOPT_SOCKETFUNCTION, &AsyncHttpClient::HttpSocketFunc);
+		curl_multi_setopt(m_multi, CURLMOPT_SOCKETDATA, this);
+		curl_multi_setopt(m_multi, CURLMOPT_TIMERFUNCTION, &AsyncHttpClient::HttpTimerFunc);
+		curl_multi_setopt(m_multi, CURLMOPT_TIMERDATA, this);
+		curl_multi_setopt(m_multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+		this->ApplyMultiOption(m_option);
+
+		m_running = true;
+
+		if (run_loop_thread)
+		{
+			m_driver = std::thread([this]()
+			{
+				while (m_running)
+					m_loop->RunOnce(-1);
+			});
+		}
+	}
+
+	virtual ~AsyncHttpClient()
+	{
+		this->Stop();
+	}
+
+	AsyncHttpClient(const AsyncHttpClient&) = delete;
+	AsyncHttpClient& operator=(const AsyncHttpClient&) = delete;
+
+private:
+	/******************************************************************************
+	*! @brief  : driver thread : add submitted transfer, perform and poll
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : void
+	******************************************************************************/
+	void DriverLoop()
+	{
+		while (m_running)
+		{
+			this->AddPendingTransfer();
+			this->AddDelayedTransfer();
+			this->CheckHedgeTransfer();
+
+			int running_handles = 0;
+			curl_multi_perform(m_multi, &running_handles);
+
+			this->ReadCompletedTransfer();
+
+			int timeout_ms = this->GetDelayedTimeout(1000);
+			int resume_ms  = this->ResumeBandwidthTransfer();
+			if (resume_ms >= 0)
+				timeout_ms = std::min(timeout_ms, resume_ms);
+
+			// wake up by curl_multi_wakeup when new transfer is submitted
+			curl_multi_poll(m_multi, NULL, 0, timeout_ms, NULL);
+		}
+
+		this->AbortAllTransfer();
+	}
+
+	static int HttpSocketFunc(CURL* easy, curl_socket_t sock, int what, void* userp, void* socketp)
+	{
+		AsyncHttpClient* client = static_cast<AsyncHttpClient*>(userp);
+		(void)easy; (void)socketp;
+
+		if (what == CURL_POLL_REMOVE)
+		{
+			client->m_loop->Unwatch(sock);
+			client->m_sockets.erase(sock);
+			return 0;
+		}
+
+		unsigned int events = 0;
+		if (what & CURL_POLL_IN)  events |= KY_HTTP_IO_READ;
+		if (what & CURL_POLL_OUT) events |= KY_HTTP_IO_WRITE;
+
+		client->m_sockets.insert(sock);
+		client->m_loop->Watch(sock, events, [client](curl_socket_t fd, unsigned int ev)
+		{
+			client->OnSocketEvent(fd, ev);
+		});
+		return 0;
+	}
+
+	static int HttpTimerFunc(CURLM* multi, long timeout_ms, void* userp)
+	{
+		AsyncHttpClient* client = static_cast<AsyncHttpClient*>(userp);
+		(void)multi;
+
+		client->m_loop->CancelTimer(client->m_curl_timer);
+		client->m_curl_timer = 0;
+
+		// -1 : delete timer (socket_action is not allowed inside this callback)
+		if (timeout_ms >= 0)
+		{
+			client->m_curl_timer = client->m_loop->AddTimer(timeout_ms, [client]()
+			{
+				client->m_curl_timer = 0;
+				client->OnSocketEvent(CURL_SOCKET_TIMEOUT, 0);
+			});
+		}
+		return 0;
+	}
+
+	void OnSocketEvent(curl_socket_t sock, unsigned int events)
+	{
+		int ev_bitmask = 0;
+		if (events & KY_HTTP_IO_READ)  ev_bitmask |= CURL_CSELECT_IN;
+		if (events & KY_HTTP_IO_WRITE) ev_bitmask |= CURL_CSELECT_OUT;
+		if (events & KY_HTTP_IO_ERROR) ev_bitmask |= CURL_CSELECT_ERR;
+
+		int running_handles = 0;
+		curl_multi_socket_action(m_multi, sock, ev_bitmask, &running_handles);
+
+		this->ReadCompletedTransfer();
+
+		if (m_bandwidth_used)
+			this->ScheduleBandwidthResume();
+	}
+
+	// loop timer for transfers paused by bandwidth governor
+	void ScheduleBandwidthResume()
+	{
+		m_loop->CancelTimer(m_bandwidth_timer);
+		m_bandwidth_timer = 0;
+
+		int resume_ms = this->ResumeBandwidthTransfer();
+		if (resume_ms < 0)
+			return;
+
+		std::shared_ptr<std::atomic<bool>> alive = m_alive;
+		m_bandwidth_timer = m_loop->AddTimer(resume_ms, [this, alive]()
+		{
+			if (!*alive)
+				return;
+
+			m_bandwidth_timer = 0;
+			this->ScheduleBandwidthResume();
+		});
+	}
+
+	// loop timer : task runs only while client is alive
+	void AddLoopTimer(long delay_ms, std::function<void()> task)
+	{
+		std::shared_ptr<std::atomic<bool>> alive = m_alive;
+		m_loop->AddTimer(delay_ms, [alive, task]()
+		{
+			if (*alive)
+				task();
+		});
+	}
+
+	// limits of multi handle : shared by all in-flight transfers
+	void ApplyMultiOption(IN const HttpClientOption& option)
+	{
+		if (option.m_max_concurrent_streams > 0)
+			curl_multi_setopt(m_multi, CURLMOPT_MAX_CONCURRENT_STREAMS, option.m_max_concurrent_streams);
+		curl_multi_setopt(m_multi, CURLMOPT_MAX_HOST_CONNECTIONS, option.m_max_host_connections);
+	}
+
+	void AddPendingTransfer()
+	{
+		std::vector<HttpTransferPtr> pending;
+		{
+			std::lock_guard<std::mutex> lock(m_pending_lock);
+			pending.swap(m_pending);
+
+			if (m_multi_option_changed)
+			{
+				this->ApplyMultiOption(m_option);
+				m_multi_option_changed = FALSE;
+			}
+		}
+
+		for (auto& transfer : pending)
+		{
+			this->StartTransfer(transfer);
+		}
+	}
+
+	// retry delay elapsed -> add to multi again
+	void AddDelayedTransfer()
+	{
+		auto now = std::chrono::steady_clock::now();
+		while (!m_delayed.empty() && m_delayed.begin()->first <= now)
+		{
+			HttpTransferPtr transfer = m_delayed.begin()->second;
+			m_delayed.erase(m_delayed.begin());
+
+			this->AddTransfer(transfer);
+		}
+	}
+
+	int GetDelayedTimeout(int timeout_ms) const
+	{
+		auto now = std::chrono::steady_clock::now();
+		long long wait = timeout_ms;
+
+		if (!m_delayed.empty())
+			wait = std::min<long long>(wait, std::chrono::duration_cast<std::chrono::milliseconds>(m_delayed.begin()->first - now).count());
+
+		if (!m_hedge_checks.empty())
+			wait = std::min<long long>(wait, std::chrono::duration_cast<std::chrono::milliseconds>(m_hedge_checks.begin()->first - now).count());
+
+		return (int)std::max<long long>(0, wait);
+	}
+
+	// continue transfers paused by bandwidth governor | return : wait (ms) of next one, -1 : none
+	int ResumeBandwidthTransfer()
+	{
+		int resume_ms = -1;
+		if (!m_bandwidth_used)
+			return resume_ms;
+
+		for (auto& it : m_transfers)
+		{
+			int wait_ms = it.second->m_client->ResumeBandwidth();
+			if (wait_ms >= 0 && (resume_ms < 0 || wait_ms < resume_ms))
+				resume_ms = wait_ms;
+		}
+		return resume_ms;
+	}
+
+	BOOL IsInFlight(HttpTransferPtr transfer) const
+	{
+		auto it = m_transfers.find(transfer->m_client->m_curl);
+		if (it != m_transfers.end() && it->second == transfer)
+			return TRUE;
+
+		for (auto& delayed : m_delayed)
+		{
+			if (delayed.second == transfer)
+				return TRUE;
+		}
+		return FALSE;
+	}
+
+	// remove from multi / retry queue without callback
+	void CancelTransfer(HttpTransferPtr transfer)
+	{
+		CURL* curl = transfer->m_client->m_curl;
+
+		auto it = m_transfers.find(curl);
+		if (it != m_transfers.end() && it->second == transfer)
+		{
+			curl_multi_remove_handle(m_multi, curl);
+			m_transfers.erase(it);
+		}
+
+		for (auto it_delayed = m_delayed.begin(); it_delayed != m_delayed.end(); )
+		{
+			if (it_delayed->second == transfer)
+				it_delayed = m_delayed.erase(it_delayed);
+			else
+				++it_delayed;
+		}
+	}
+
+	/******************************************************************************
+	*! @brief  : hedge delay elapsed -> duplicate GET still waiting for first byte
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : void
+	******************************************************************************/
+	void CheckHedgeTransfer()
+	{
+		auto now = std::chrono::steady_clock::now();
+		while (!m_hedge_checks.empty() && m_hedge_checks.begin()->first <= now)
+		{
+			HttpTransferPtr transfer = m_hedge_checks.begin()->second.lock();
+			m_hedge_checks.erase(m_hedge_checks.begin());
+
+			if (!transfer || transfer->m_completed || !this->IsInFlight(transfer))
+				continue;
+
+			curl_off_t first_byte = 0;
+			curl_easy_getinfo(transfer->m_client->m_curl, CURLINFO_STARTTRANSFER_TIME_T, &first_byte);
+			if (first_byte > 0)
+				continue;
+
+			if (!transfer->m_hedge_policy->TryHedge())
+				continue;
+
+			HttpClientPtr client = transfer->m_client->DuplicateTransfer();
+			if (!client)
+				continue;
+
+			HttpTransferPtr hedge = std::make_shared<HttpTransfer>();
+			hedge->m_client		  = client;
+			hedge->m_request	  = transfer->m_request;
+			hedge->m_method		  = transfer->m_method;
+			hedge->m_uri		  = transfer->m_uri;
+			hedge->m_callback	  = transfer->m_callback;
+			hedge->m_hedge_policy = transfer->m_hedge_policy;
+			hedge->m_is_hedge	  = TRUE;
+
+			transfer->m_completed = hedge->m_completed = std::make_shared<BOOL>(FALSE);
+			transfer->m_sibling	  = hedge;
+			hedge->m_sibling	  = transfer;
+
+			KY_HTTP_LOG("Hedge request : %s", transfer->m_uri.get_url().c_str());
+			this->AddTransfer(hedge);
+		}
+	}
+
+	void ScheduleHedgeCheck(HttpTransferPtr transfer)
+	{
+		HttpHedgePolicyPtr policy = transfer->m_hedge_policy;
+		policy->OnRequest();
+
+		UINT delay_ms = policy->GetDelay();
+		m_hedge_checks.insert(std::make_pair(std::chrono::steady_clock::now() + std::chrono::milliseconds(delay_ms),
+											 HttpTransferWPtr(transfer)));
+
+		if (m_loop)
+			this->AddLoopTimer(delay_ms, [this]() { this->CheckHedgeTransfer(); });
+	}
+
+	void StartTransfer(HttpTransferPtr transfer)
+	{
+		HttpClientPtr client = transfer->m_client;
+		HttpErrorCode retcode = client->PrepareRequest(transfer->m_method, transfer->m_request.get());
+
+		if (retcode == HttpErrorCode::KY_HTTP_OK)
+			retcode = client->CheckCircuit(transfer->m_uri);
+
+		if (retcode != HttpErrorCode::KY_HTTP_OK)
+		{
+			this->CompleteTransfer(transfer, retcode);
+			return;
+		}
+
+		std::string url = transfer->m_uri.get_url();
+		client->Curl_SetupUrl(client->m_curl, url.c_str());
+
+		// hedge : GET, body kept in response (sink can not be written twice)
+		if (transfer->m_hedge_policy && (transfer->m_method != HttpMethod::GET || client->m_sink))
+			transfer->m_hedge_policy = nullptr;
+
+		if (transfer->m_hedge_policy)
+			transfer->m_start_time = std::chrono::steady_clock::now();
+
+		if (client->m_bandwidth_governor)
+			m_bandwidth_used = TRUE;
+
+		this->AddTransfer(transfer);
+
+		if (transfer->m_hedge_policy)
+			this->ScheduleHedgeCheck(transfer);
+	}
+
+	void AddTransfer(HttpTransferPtr transfer)
+	{
+		CURL* curl = transfer->m_client->m_curl;
+
+		if (curl_multi_add_handle(m_multi, curl) != CURLM_OK)
+		{
+			this->CompleteTransfer(transfer, HttpErrorCode::KY_HTTP_FAILED);
+			return;
+		}
+
+		m_transfers[curl] = transfer;
+	}
+
+	void ReadCompletedTransfer()
+	{
+		int msgs_left = 0;
+		CURLMsg* msg = NULL;
+
+		while ((msg = curl_multi_info_read(m_multi, &msgs_left)) != NULL)
+		{
+			if (msg->msg != CURLMSG_DONE)
+				continue;
+
+			CURL* curl = msg->easy_handle;
+			CURLcode curlret = msg->data.result;
+
+			auto it = m_transfers.find(curl);
+			if (it == m_transfers.end())
+				continue;
+
+			HttpTransferPtr transfer = it->second;
+			m_transfers.erase(it);
+			curl_multi_remove_handle(m_multi, curl);
+
+			this->OnTransferDone(transfer, curlret);
+		}
+	}
+
+	void OnTransferDone(HttpTransferPtr transfer, CURLcode curlret)
+	{
+		HttpErrorCode retcode = HttpErrorCode::KY_HTTP_FAILED;
+		UINT delay_ms = 0;
+
+		// retry, redirect -> run again
+		if (transfer->m_client->OnMultiTransferDone(curlret, transfer->m_uri, delay_ms, retcode))
+		{
+			if (delay_ms == 0)
+			{
+				this->AddTransfer(transfer);
+				return;
+			}
+
+			m_delayed.insert(std::make_pair(std::chrono::steady_clock::now() + std::chrono::milliseconds(delay_ms), transfer));
+
+			if (m_loop)
+				this->AddLoopTimer(delay_ms, [this]() { this->AddDelayedTransfer(); });
+			return;
+		}
+
+		HttpTransferPtr sibling = transfer->m_sibling.lock();
+		if (sibling && !*transfer->m_completed)
+		{
+			// failed first -> result is given by the other one
+			if (retcode != HttpErrorCode::KY_HTTP_OK && this->IsInFlight(sibling))
+			{
+				transfer->m_sibling.reset();
+				sibling->m_sibling.reset();
+				return;
+			}
+
+			this->CancelTransfer(sibling);
+			transfer->m_hedge_policy->CountFinish(transfer->m_is_hedge);
+		}
+
+		if (transfer->m_hedge_policy && retcode == HttpErrorCode::KY_HTTP_OK)
+		{
+			UINT latency_ms = 0;
+
+			// hedge won : latency without hedge is at least the wait of primary
+			if (transfer->m_is_hedge && sibling)
+			{
+				latency_ms = (UINT)std::chrono::duration_cast<std::chrono::milliseconds>(
+					std::chrono::steady_clock::now() - sibling->m_start_time).count();
+			}
+			else
+			{
+				curl_off_t first_byte = 0;
+				curl_easy_getinfo(transfer->m_client->m_curl, CURLINFO_STARTTRANSFER_TIME_T, &first_byte);
+				latency_ms = (UINT)(first_byte / 1000);
+			}
+			transfer->m_hedge_policy->AddLatency(latency_ms);
+		}
+
+		this->CompleteTransfer(transfer, retcode);
+	}
+
+	static void CompleteTransfer(HttpTransferPtr transfer, HttpErrorCode retcode)
+	{
+		// hedge pair : first one only
+		if (transfer->m_completed)
+		{
+			if (*transfer->m_completed)
+				return;
+			*transfer->m_completed = TRUE;
+		}
+
+		HttpResponsePtr response = transfer->m_client->Response();
+
+		// failed before curl handle is ready -> always give back a response
+		if (!response)
+		{
+			response = std::make_shared<HttpResponse>();
+		}
+		response->m_error_code = retcode;
+		transfer->m_client->CompleteSink(retcode);
+
+		if (transfer->m_callback)
+		{
+			transfer->m_callback(retcode, response);
+		}
+	}
+
+	void AbortAllTransfer()
+	{
+		for (auto& it : m_transfers)
+		{
+			curl_multi_remove_handle(m_multi, it.first);
+			this->CompleteTransfer(it.second, HttpErrorCode::KY_HTTP_USER_FORCE_STOP);
+		}
+		m_transfers.clear();
+
+		for (auto& it : m_delayed)
+		{
+			this->CompleteTransfer(it.second, HttpErrorCode::KY_HTTP_USER_FORCE_STOP);
+		}
+		m_delayed.clear();
+		m_hedge_checks.clear();
+
+		std::vector<HttpTransferPtr> pending;
+		{
+			std::lock_guard<std::mutex> lock(m_pending_lock);
+			pending.swap(m_pending);
+		}
+
+		for (auto& transfer : pending)
+		{
+			this->CompleteTransfer(transfer, HttpErrorCode::KY_HTTP_USER_FORCE_STOP);
+		}
+	}
+
+	// m_pending_lock held : settings are copied to the client of one transfer
+	HttpClientPtr CreateClient()
+	{
+		HttpClientPtr client = std::make_shared<HttpClient>();
+		client->Configunation(m_option);
+		client->SettingSSL(m_ssl_setting);
+		client->SettingProxy(m_proxy);
+		client->AttachSharePool(m_share_pool);
+		client->AttachRetryPolicy(m_retry_policy);
+		client->AttachCircuitBreaker(m_circuit_breaker);
+		client->AttachBandwidthGovernor(m_bandwidth_governor);
+
+		return client;
+	}
+
+	HttpErrorCode Submit(IN HttpMethod method, IN const Uri& uri, IN HttpRequestPtr request,
+						 IN HttpCompletionFunc callback)
+	{
+		if (HttpMethod::POST == method && nullptr == request)
+		{
+			KY_HTTP_LOG_ERROR("Post request nulls is not allowed !");
+			return HttpErrorCode::KY_HTTP_FAILED;
+		}
+
+		HttpTransferPtr transfer = std::make_shared<HttpTransfer>();
+		transfer->m_request	 = request;
+		transfer->m_method	 = method;
+		transfer->m_uri		 = uri;
+		transfer->m_callback = callback;
+
+		// Stop takes the lock before cleanup of multi handle
+		std::lock_guard<std::mutex> lock(m_pending_lock);
+
+		if (!m_multi || !m_running)
+		{
+			KY_HTTP_LOG_ERROR("Async client is not running !");
+			return HttpErrorCode::KY_HTTP_INIT_REQUEST_FAIL;
+		}
+
+		transfer->m_client		 = this->CreateClient();
+		transfer->m_hedge_policy = m_hedge_policy;
+
+		m_pending.push_back(transfer);
+
+		if (m_loop)
+		{
+			std::shared_ptr<std::atomic<bool>> alive = m_alive;
+			m_loop->Post([this, alive]()
+			{
+				if (*alive)
+					this->AddPendingTransfer();
+			});
+		}
+		else
+		{
+			curl_multi_wakeup(m_multi);
+		}
+
+		return HttpErrorCode::KY_HTTP_OK;
+	}
+
+public:
+	// apply for next submitted requests
+	// m_max_concurrent_streams / m_max_host_connections : limits of the client (all transfers)
+	void Configunation(IN HttpClientOption& option)
+	{
+		std::lock_guard<std::mutex> lock(m_pending_lock);
+		m_option = option;
+		m_multi_option_changed = TRUE;
+	}
+
+	void SettingProxy(IN WebProxy& proxy_info)
+	{
+		std::lock_guard<std::mutex> lock(m_pending_lock);
+		m_proxy = proxy_info;
+	}
+
+	void SettingSSL(IN SSLSetting& ssl_setting)
+	{
+		std::lock_guard<std::mutex> lock(m_pending_lock);
+		m_ssl_setting = ssl_setting;
+	}
+
+	// DNS / TLS session pool : connections stay in the cache of multi handle (driver thread)
+	void AttachSharePool(IN HttpSharePoolPtr share_pool)
+	{
+		if (share_pool && share_pool->IsShareConnection())
+		{
+			KY_HTTP_LOG_WARN("Share pool with connection sharing is not attached to async client.");
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_pending_lock);
+		m_share_pool = share_pool;
+	}
+
+	// apply for next submitted requests (retry delay does not block driver thread)
+	void AttachRetryPolicy(IN HttpRetryPolicyPtr retry_policy)
+	{
+		std::lock_guard<std::mutex> lock(m_pending_lock);
+		m_retry_policy = retry_policy;
+	}
+
+	/******************************************************************************
+	*! @brief  : hedged GET : duplicate request when first byte is not received
+	*!			 after delay of policy, first finished is given to callback and
+	*!			 the other is cancelled (apply for next submitted requests)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	hedge_policy : nullptr : off
+	*! @return : void
+	******************************************************************************/
+	void AttachHedgePolicy(IN HttpHedgePolicyPtr hedge_policy)
+	{
+		std::lock_guard<std::mutex> lock(m_pending_lock);
+		m_hedge_policy = hedge_policy;
+	}
+
+	// apply for next submitted requests (HttpBandwidthGovernor::Global() : limit shared with sync clients)
+	void AttachBandwidthGovernor(IN HttpBandwidthGovernorPtr bandwidth_governor)
+	{
+		std::lock_guard<std::mutex> lock(m_pending_lock);
+		m_bandwidth_governor = bandwidth_governor;
+	}
+
+	// apply for next submitted requests (HttpCircuitBreaker::Global() : state shared with sync clients)
+	void AttachCircuitBreaker(IN HttpCircuitBreakerPtr circuit_breaker)
+	{
+		std::lock_guard<std::mutex> lock(m_pending_lock);
+		m_circuit_breaker = circuit_breaker;
+	}
+
+	/******************************************************************************
+	*! @brief  : stop driver / loop thread, in-flight transfer completed with USER_FORCE_STOP
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : void
+	******************************************************************************/
+	void Stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_pending_lock);
+			if (m_running.exchange(false) && m_multi && !m_loop)
+			{
+				curl_multi_wakeup(m_multi);
+			}
+		}
+
+		if (m_loop)
+		{
+			*m_alive = false;
+			m_loop->Wakeup();
+		}
+
+		if (m_driver.joinable())
+		{
+			m_driver.join();
+		}
+
+		// submitted while driver thread was leaving
+		this->AbortAllTransfer();
+
+		{
+			std::lock_guard<std::mutex> lock(m_pending_lock);
+			curl_multi_cleanup(m_multi);
+			m_multi = NULL;
+		}
+
+		if (m_loop)
+		{
+			for (auto sock : m_sockets)
+			{
+				m_loop->Unwatch(sock);
+			}
+			m_sockets.clear();
+
+			m_loop->CancelTimer(m_curl_timer);
+			m_curl_timer = 0;
+
+			m_loop->CancelTimer(m_bandwidth_timer);
+			m_bandwidth_timer = 0;
+		}
+	}
+
+	/******************************************************************************
+	*! @brief  : send request without blocking
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	method : GET / POST
+	*! @parameter:	request : header and content (nullptr allowed for GET)
+	*! @parameter:	callback : called on driver thread when transfer done
+	*! @return : HttpErrorCode : submit result
+	******************************************************************************/
+	HttpErrorCode RequestAsync(IN HttpMethod method, IN const Uri& uri, IN HttpRequestPtr request,
+							   IN HttpCompletionFunc callback)
+	{
+		return this->Submit(method, uri, request, callback);
+	}
+
+	/******************************************************************************
+	*! @brief  : send request without blocking
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : future : response (HttpResponse::GetErrorCode() for result)
+	******************************************************************************/
+	std::future<HttpResponsePtr> RequestAsync(IN HttpMethod method, IN const Uri& uri, IN HttpRequestPtr request)
+	{
+		auto promise = std::make_shared<std::promise<HttpResponsePtr>>();
+		std::future<HttpResponsePtr> future = promise->get_future();
+
+		HttpErrorCode retcode = this->Submit(method, uri, request,
+			[promise](HttpErrorCode code, HttpResponsePtr response)
+			{
+				promise->set_value(response);
+			});
+
+		if (retcode != HttpErrorCode::KY_HTTP_OK)
+		{
+			HttpResponsePtr response = std::make_shared<HttpResponse>();
+			response->m_error_code = retcode;
+			promise->set_value(response);
+		}
+
+		return future;
+	}
+
+#ifdef KYHTTP_COROUTINE
+	/*==================================================================================
+	* Class HttpResponseAwaiter
+	* Awaitable for one request, submitted on co_await (not on creation).
+	* Keep it as temporary object of co_await expression.
+	===================================================================================*/
+	class HttpResponseAwaiter
+	{
+	private:
+		AsyncHttpClient*	m_client;
+		HttpMethod			m_method;
+		Uri					m_uri;
+		HttpRequestPtr		m_request;
+		HttpResponsePtr		m_response;
+
+	public:
+		HttpResponseAwaiter(IN AsyncHttpClient* client, IN HttpMethod method, IN const Uri& uri, IN HttpRequestPtr request) :
+			m_client(client), m_method(method), m_uri(uri), m_request(request)
+		{
+
+		}
+
+		bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		bool await_suspend(std::coroutine_handle<> handle)
+		{
+			// callback may resume the coroutine before Submit returns -> do not touch members after success
+			HttpErrorCode retcode = m_client->Submit(m_method, m_uri, m_request,
+				[this, handle](HttpErrorCode code, HttpResponsePtr response)
+				{
+					m_response = response;
+					handle.resume();
+				});
+
+			if (retcode != HttpErrorCode::KY_HTTP_OK)
+			{
+				m_response = std::make_shared<HttpResponse>();
+				m_response->m_error_code = retcode;
+				return false; // not submitted : continue without suspend
+			}
+
+			return true;
+		}
+
+		HttpResponsePtr await_resume() noexcept
+		{
+			return m_response;
+		}
+	};
+
+	/******************************************************************************
+	*! @brief  : co_await GET request
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : awaitable -> HttpResponsePtr (HttpResponse::GetErrorCode() for result)
+	******************************************************************************/
+	HttpResponseAwaiter GetAsync(IN const Uri& uri, IN HttpRequestPtr request = nullptr)
+	{
+		return HttpResponseAwaiter(this, HttpMethod::GET, uri, request);
+	}
+
+	/******************************************************************************
+	*! @brief  : co_await POST request
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : awaitable -> HttpResponsePtr (HttpResponse::GetErrorCode() for result)
+	******************************************************************************/
+	HttpResponseAwaiter PostAsync(IN const Uri& uri, IN HttpRequestPtr request)
+	{
+		return HttpResponseAwaiter(this, HttpMethod::POST, uri, request);
+	}
+#endif // KYHTTP_COROUTINE
+};
+
+__END___NAMESPACE__
@@ -0,0 +1,348 @@
+/*!**********************************************************************
+* @copyright Copyright (C) 2022 thuong.nv -email: mark.ngo@kohyoung.com.\n
+*            All rights reserved.
+*************************************************************************
+* @file     kyhttp_bandwidth.h
+* @date     Oct 17, 2026
+* @brief    HTTP client libcurl implementation file.
+*
+** Bandwidth governor : total download / upload rate shared by transfers (priority)
+*************************************************************************/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <algorithm>
+#include <Windows.h>
+#include <curl/curl.h>
+
+#include "kyhttp_types.h"
+
+__BEGIN_NAMESPACE__
+
+class HttpBandwidthGovernor;
+typedef std::shared_ptr<HttpBandwidthGovernor> HttpBandwidthGovernorPtr;
+
+struct HttpBandwidthStats
+{
+	unsigned long long	m_download_bytes;
+	unsigned long long	m_upload_bytes;
+	unsigned long long	m_throttle_count;	// transfer waited / paused over its share
+	unsigned long long	m_throttle_time;	// ms
+};
+
+/*==================================================================================
+* Class HttpBandwidthGovernor
+* Attach to HttpClient / AsyncHttpClient (AttachBandwidthGovernor), HttpBandwidthGovernor::Global()
+* limits all clients of process.
+*
+* Share :	transfer receiving (or sending) data gets total rate * priority / sum of priority
+*			of active transfers in same direction (HttpClientOption::m_bandwidth_priority)
+*			-> bulk transfers (LOW) do not starve API calls (HIGH)
+* Throttle : token bucket of transfer, download counted in write callback, upload in
+*			progress callback. Over share -> HttpClient::Request waits in callback / multi
+*			transfer paused (CURL_WRITEFUNC_PAUSE, curl_easy_pause) and continued by driver loop
+===================================================================================*/
+class HttpBandwidthGovernor
+{
+public:
+	enum { DOWNLOAD = 0, UPLOAD = 1 };
+
+private:
+	std::atomic<unsigned long long>	m_rate[2];		// bytes/s | 0 : no limit
+	std::atomic<unsigned long long>	m_weight[2];	// sum of priority of active transfers
+
+	std::atomic<unsigned long long>	m_bytes[2];
+	std::atomic<unsigned long long>	m_throttle_count;
+	std::atomic<unsigned long long>	m_throttle_time;
+
+public:
+	HttpBandwidthGovernor(IN ULONG max_download_speed = 0, IN ULONG max_upload_speed = 0) :
+		m_throttle_count(0),
+		m_throttle_time(0)
+	{
+		for (int direction = 0; direction < 2; direction++)
+		{
+			m_rate[direction]	= 0;
+			m_weight[direction] = 0;
+			m_bytes[direction]	= 0;
+		}
+		this->SetLimit(max_download_speed, max_upload_speed);
+	}
+
+	HttpBandwidthGovernor(const HttpBandwidthGovernor&) = delete;
+	HttpBandwidthGovernor& operator=(const HttpBandwidthGovernor&) = delete;
+
+public:
+	/******************************************************************************
+	*! @brief  : total rate of all attached clients (can be changed while transfers run)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	max_download_speed : kb/s | 0 : no limit
+	*! @parameter:	max_upload_speed : kb/s | 0 : no limit
+	*! @return : void
+	******************************************************************************/
+	void SetLimit(IN ULONG max_download_speed, IN ULONG max_upload_speed)
+	{
+		m_rate[DOWNLOAD] = 1024ULL * max_download_speed;
+		m_rate[UPLOAD]	 = 1024ULL * max_upload_speed;
+	}
+
+	void Join(IN int direction, IN UINT weight)
+	{
+		m_weight[direction].fetch_add(weight);
+	}
+
+	void Leave(IN int direction, IN UINT weight)
+	{
+		m_weight[direction].fetch_sub(weight);
+	}
+
+	// rate of one active transfer (bytes/s) | 0 : no limit
+	double GetShare(IN int direction, IN UINT weight) const
+	{
+		unsigned long long rate = m_rate[direction].load(std::memory_order_relaxed);
+		if (rate == 0)
+			return 0.0;
+
+		unsigned long long total_weight = std::max<unsigned long long>(m_weight[direction].load(std::memory_order_relaxed), weight);
+		return (double)rate * weight / (double)total_weight;
+	}
+
+	void CountBytes(IN int direction, IN unsigned long long nbytes)
+	{
+		m_bytes[direction].fetch_add(nbytes, std::memory_order_relaxed);
+	}
+
+	void CountThrottle(IN UINT wait_ms)
+	{
+		m_throttle_count.fetch_add(1, std::memory_order_relaxed);
+		m_throttle_time.fetch_add(wait_ms, std::memory_order_relaxed);
+	}
+
+	HttpBandwidthStats GetStats() const
+	{
+		HttpBandwidthStats stats;
+		stats.m_download_bytes = m_bytes[DOWNLOAD].load();
+		stats.m_upload_bytes   = m_bytes[UPLOAD].load();
+		stats.m_throttle_count = m_throttle_count.load();
+		stats.m_throttle_time  = m_throttle_time.load();
+		return stats;
+	}
+
+	/******************************************************************************
+	*! @brief  : governor of process (no limit until SetLimit)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : HttpBandwidthGovernorPtr
+	******************************************************************************/
+	static HttpBandwidthGovernorPtr Global()
+	{
+		static HttpBandwidthGovernorPtr global_governor = std::make_shared<HttpBandwidthGovernor>();
+		return global_governor;
+	}
+};
+
+/*==================================================================================
+* Class HttpBandwidthLimiter
+* Token bucket of one client (current transfer), used by curl callbacks of its handle
+* Active direction follows data : upload -> download (response) leaves upload share
+===================================================================================*/
+class HttpBandwidthLimiter
+{
+	typedef std::chrono::steady_clock Clock;
+
+	static const UINT BURST_TIME = 100;		// ms
+	static const UINT MAX_WAIT	 = 1000;	// ms
+
+private:
+	HttpBandwidthGovernorPtr	m_governor;
+	CURL*						m_curl;
+	UINT						m_weight;
+	BOOL						m_wait;			// TRUE : wait in callback (curl_easy_perform) / FALSE : pause (multi)
+
+	int							m_direction;	// active direction | -1 : no data yet
+	double						m_tokens;		// bytes
+	Clock::time_point			m_refill_time;
+	double						m_last_bytes[2];
+
+	BOOL						m_paused;
+	Clock::time_point			m_resume_time;
+
+public:
+	explicit HttpBandwidthLimiter(IN HttpBandwidthGovernorPtr governor) :
+		m_governor(governor),
+		m_curl(NULL),
+		m_weight(KY_HTTP_PRIORITY_NORMAL),
+		m_wait(FALSE),
+		m_direction(-1),
+		m_tokens(0.0),
+		m_paused(FALSE)
+	{
+		m_last_bytes[0] = m_last_bytes[1] = 0.0;
+	}
+
+	~HttpBandwidthLimiter()
+	{
+		this->End();
+	}
+
+	HttpBandwidthLimiter(const HttpBandwidthLimiter&) = delete;
+	HttpBandwidthLimiter& operator=(const HttpBandwidthLimiter&) = delete;
+
+private:
+	void SetDirection(IN int direction)
+	{
+		if (m_direction >= 0)
+			m_governor->Leave(m_direction, m_weight);
+
+		m_direction = direction;
+
+		if (m_direction >= 0)
+		{
+			m_governor->Join(m_direction, m_weight);
+
+			// small request is not delayed by first chunk
+			double share  = m_governor->GetShare(m_direction, m_weight);
+			m_tokens	  = share * BURST_TIME / 1000.0;
+			m_refill_time = Clock::now();
+		}
+	}
+
+public:
+	HttpBandwidthGovernorPtr GetGovernor() const
+	{
+		return m_governor;
+	}
+
+	// new request on curl handle
+	void Begin(IN CURL* curl, IN HttpBandwidthPriority priority)
+	{
+		this->End();
+
+		m_curl	 = curl;
+		m_weight = (priority > 0) ? (UINT)priority : 1;
+		m_wait	 = FALSE;
+	}
+
+	// request done : share given back to other transfers
+	void End()
+	{
+		this->SetDirection(-1);
+
+		m_last_bytes[0] = m_last_bytes[1] = 0.0;
+		m_paused = FALSE;
+	}
+
+	void SetWait(IN BOOL wait)
+	{
+		m_wait = wait;
+	}
+
+	/******************************************************************************
+	*! @brief  : count data of transfer, throttle when over share
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	direction : DOWNLOAD / UPLOAD
+	*! @parameter:	nbytes : bytes received / sent since last call
+	*! @return : TRUE : continue (waited if needed) / FALSE : pause transfer (multi)
+	******************************************************************************/
+	BOOL Consume(IN int direction, IN double nbytes)
+	{
+		if (nbytes <= 0)
+			return TRUE;
+
+		// response received : request body is done -> leave upload share
+		if (direction != m_direction && (direction == HttpBandwidthGovernor::DOWNLOAD || m_direction < 0))
+			this->SetDirection(direction);
+
+		if (direction != m_direction)
+			return TRUE;
+
+		m_governor->CountBytes(direction, (unsigned long long)nbytes);
+
+		double share = m_governor->GetShare(direction, m_weight);
+		if (share <= 0.0)
+			return TRUE;
+
+		Clock::time_point now = Clock::now();
+		double elapsed = std::chrono::duration<double>(now - m_refill_time).count();
+		m_refill_time = now;
+
+		m_tokens  = std::min(m_tokens + share * elapsed, share * BURST_TIME / 1000.0);
+		m_tokens -= nbytes;
+
+		if (m_tokens >= 0.0)
+			return TRUE;
+
+		UINT wait_ms = (UINT)std::min<double>(MAX_WAIT, (-m_tokens / share) * 1000.0 + 1);
+		m_governor->CountThrottle(wait_ms);
+
+		if (m_wait)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(wait_ms));
+			return TRUE;
+		}
+
+		m_paused	  = TRUE;
+		m_resume_time = now + std::chrono::milliseconds(wait_ms);
+		return FALSE;
+	}
+
+	/******************************************************************************
+	*! @brief  : write callback : received data (bytes on wire, before decoding)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : TRUE : deliver data / FALSE : return CURL_WRITEFUNC_PAUSE (same data
+	*!			 is given again after Resume)
+	******************************************************************************/
+	BOOL OnReceive()
+	{
+		curl_off_t received = 0;
+		curl_easy_getinfo(m_curl, CURLINFO_SIZE_DOWNLOAD_T, &received);
+
+		// new attempt (retry, redirect) : counter restarted from 0
+		double nbytes = (double)received - m_last_bytes[HttpBandwidthGovernor::DOWNLOAD];
+		if (nbytes < 0)
+			nbytes = (double)received;
+		m_last_bytes[HttpBandwidthGovernor::DOWNLOAD] = (double)received;
+
+		return this->Consume(HttpBandwidthGovernor::DOWNLOAD, nbytes);
+	}
+
+	/******************************************************************************
+	*! @brief  : progress callback : sent data (any content type, curl reads body itself)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	now_upload : bytes sent by current attempt
+	*! @return : void
+	******************************************************************************/
+	void OnProgress(IN double now_upload)
+	{
+		double nbytes = now_upload - m_last_bytes[HttpBandwidthGovernor::UPLOAD];
+		if (nbytes < 0)
+			nbytes = now_upload;
+		m_last_bytes[HttpBandwidthGovernor::UPLOAD] = now_upload;
+
+		if (!this->Consume(HttpBandwidthGovernor::UPLOAD, nbytes))
+			curl_easy_pause(m_curl, CURLPAUSE_SEND);
+	}
+
+	/******************************************************************************
+	*! @brief  : multi : continue paused transfer when its wait elapsed
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : wait (ms) before transfer can continue | -1 : not paused
+	******************************************************************************/
+	int Resume()
+	{
+		if (!m_paused)
+			return -1;
+
+		auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(m_resume_time - Clock::now()).count();
+		if (wait > 0)
+			return (int)wait;
+
+		m_paused = FALSE;
+		curl_easy_pause(m_curl, CURLPAUSE_CONT);
+		return -1;
+	}
+};
+
+__END___NAMESPACE__
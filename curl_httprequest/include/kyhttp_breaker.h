@@ -0,0 +1,361 @@
+/*!**********************************************************************
+* @copyright Copyright (C) 2022 thuong.nv -email: mark.ngo@kohyoung.com.\n
+*            All rights reserved.
+*************************************************************************
+* @file     kyhttp_breaker.h
+* @date     Oct 17, 2026
+* @brief    HTTP client libcurl implementation file.
+*
+** Circuit breaker by host : fail fast when server is down (no connect timeout)
+*************************************************************************/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <Windows.h>
+
+#include "kyhttp_types.h"
+#include "kyhttp_logger.h"
+
+__BEGIN_NAMESPACE__
+
+class HttpCircuitBreaker;
+typedef std::shared_ptr<HttpCircuitBreaker> HttpCircuitBreakerPtr;
+
+enum HttpCircuitState
+{
+	KY_HTTP_CIRCUIT_CLOSED = 0,		// requests sent, results counted
+	KY_HTTP_CIRCUIT_OPENED,			// requests rejected until open time elapsed
+	KY_HTTP_CIRCUIT_HALF_OPEN,		// one probe request, result closes or opens again
+};
+
+struct HttpCircuitStats
+{
+	unsigned long long	m_open_count;		// closed / half-open -> open
+	unsigned long long	m_reject_count;		// request failed fast (KY_HTTP_CIRCUIT_OPEN)
+	unsigned long long	m_probe_count;
+};
+
+/*==================================================================================
+* Class HttpCircuitBreaker
+* Attach to HttpClient / AsyncHttpClient (AttachCircuitBreaker), HttpCircuitBreaker::Global()
+* is shared by all clients of process.
+*
+* Closed :	attempt results counted in rolling window (buckets), failure ratio over
+*			threshold (with minimum attempts) -> open
+* Open :	rejected with KY_HTTP_CIRCUIT_OPEN until open time elapsed -> half-open
+* Half-open : one request is the probe, success -> closed / failure -> open again
+*			(probe without result : next probe after open time)
+*
+* Failure : connect / resolve / timeout / send / receive / SSL connect error, status 5xx
+*
+* Lock-free : fixed table of origin slots (hash, linear probing), state and counters are
+* atomic. Counters of a bucket can lose some results when the bucket is recycled.
+===================================================================================*/
+class HttpCircuitBreaker
+{
+public:
+	enum { SLOT_COUNT = 256, BUCKET_COUNT = 10 };
+
+protected:
+	enum CircuitResult { CIRCUIT_SUCCESS, CIRCUIT_FAILURE, CIRCUIT_IGNORE };
+
+private:
+	struct CircuitBucket
+	{
+		std::atomic<LONGLONG>		m_epoch;		// window time / bucket time | -1 : empty
+		std::atomic<UINT>			m_success;
+		std::atomic<UINT>			m_failure;
+	};
+
+	struct CircuitSlot
+	{
+		std::atomic<unsigned long long>	m_key;		// hash of origin | 0 : free
+		std::atomic<int>			m_state;
+		std::atomic<LONGLONG>		m_open_until;	// ms
+		std::atomic<LONGLONG>		m_probe_time;	// ms : probe sent | 0 : no probe
+		CircuitBucket				m_buckets[BUCKET_COUNT];
+	};
+
+	double							m_failure_ratio;
+	UINT							m_min_request;
+	UINT							m_open_time;	// ms
+	UINT							m_bucket_time;	// ms : window / BUCKET_COUNT
+
+	CircuitSlot						m_slots[SLOT_COUNT];
+
+	std::atomic<unsigned long long>	m_open_count;
+	std::atomic<unsigned long long>	m_reject_count;
+	std::atomic<unsigned long long>	m_probe_count;
+
+public:
+	HttpCircuitBreaker(IN double failure_ratio = 0.5, IN UINT min_request = 10,
+					   IN UINT open_time_ms = 5000, IN UINT window_ms = 10000) :
+		m_failure_ratio(failure_ratio),
+		m_min_request(min_request > 0 ? min_request : 1),
+		m_open_time(open_time_ms),
+		m_bucket_time(window_ms >= BUCKET_COUNT ? window_ms / BUCKET_COUNT : 1),
+		m_open_count(0),
+		m_reject_count(0),
+		m_probe_count(0)
+	{
+		for (auto& slot : m_slots)
+		{
+			slot.m_key		  = 0;
+			slot.m_state	  = KY_HTTP_CIRCUIT_CLOSED;
+			slot.m_open_until = 0;
+			slot.m_probe_time = 0;
+			ClearBuckets(slot);
+		}
+	}
+
+	virtual ~HttpCircuitBreaker() {}
+
+	HttpCircuitBreaker(const HttpCircuitBreaker&) = delete;
+	HttpCircuitBreaker& operator=(const HttpCircuitBreaker&) = delete;
+
+private:
+	static LONGLONG NowMs()
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	// FNV-1a (0 is free slot)
+	static unsigned long long HashOrigin(IN const std::string& origin)
+	{
+		unsigned long long hash = 14695981039346656037ULL;
+		for (unsigned char c : origin)
+		{
+			hash ^= c;
+			hash *= 1099511628211ULL;
+		}
+		return hash ? hash : 1;
+	}
+
+	static void ClearBuckets(IN OUT CircuitSlot& slot)
+	{
+		for (auto& bucket : slot.m_buckets)
+		{
+			bucket.m_epoch	 = -1;
+			bucket.m_success = 0;
+			bucket.m_failure = 0;
+		}
+	}
+
+	// slot of origin, taken at first use | nullptr : table full (no breaker)
+	CircuitSlot* FindSlot(IN const std::string& origin)
+	{
+		unsigned long long key = HashOrigin(origin);
+
+		for (size_t i = 0; i < SLOT_COUNT; i++)
+		{
+			CircuitSlot& slot = m_slots[(key + i) % SLOT_COUNT];
+
+			unsigned long long slot_key = slot.m_key.load(std::memory_order_acquire);
+			if (slot_key == 0 && slot.m_key.compare_exchange_strong(slot_key, key))
+				return &slot;
+
+			if (slot_key == key)
+				return &slot;
+		}
+		return nullptr;
+	}
+
+	void Record(IN OUT CircuitSlot& slot, IN BOOL failure, IN LONGLONG now)
+	{
+		LONGLONG epoch = now / m_bucket_time;
+		CircuitBucket& bucket = slot.m_buckets[epoch % BUCKET_COUNT];
+
+		LONGLONG old_epoch = bucket.m_epoch.load(std::memory_order_acquire);
+		if (old_epoch != epoch && bucket.m_epoch.compare_exchange_strong(old_epoch, epoch))
+		{
+			bucket.m_success = 0;
+			bucket.m_failure = 0;
+		}
+
+		if (failure)
+			bucket.m_failure.fetch_add(1, std::memory_order_relaxed);
+		else
+			bucket.m_success.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	BOOL IsFailureRateExceeded(IN CircuitSlot& slot, IN LONGLONG now) const
+	{
+		LONGLONG epoch = now / m_bucket_time;
+		UINT success = 0, failure = 0;
+
+		for (auto& bucket : slot.m_buckets)
+		{
+			LONGLONG bucket_epoch = bucket.m_epoch.load(std::memory_order_acquire);
+			if (bucket_epoch < 0 || epoch - bucket_epoch >= BUCKET_COUNT)
+				continue;
+
+			success += bucket.m_success.load(std::memory_order_relaxed);
+			failure += bucket.m_failure.load(std::memory_order_relaxed);
+		}
+
+		UINT total = success + failure;
+		return (total >= m_min_request && failure >= m_failure_ratio * total) ? TRUE : FALSE;
+	}
+
+	void Open(IN OUT CircuitSlot& slot, IN int from_state, IN LONGLONG now, IN const std::string& origin)
+	{
+		slot.m_open_until.store(now + m_open_time, std::memory_order_relaxed);
+		slot.m_probe_time.store(0, std::memory_order_relaxed);
+
+		if (slot.m_state.compare_exchange_strong(from_state, KY_HTTP_CIRCUIT_OPENED, std::memory_order_release))
+		{
+			m_open_count++;
+			KY_HTTP_LOG_WARN("[Circuit] %s : open for %u ms.", origin.c_str(), m_open_time);
+		}
+	}
+
+protected:
+	virtual CircuitResult Classify(IN HttpErrorCode retcode, IN LONG status) const
+	{
+		switch (retcode)
+		{
+		case HttpErrorCode::KY_HTTP_OK:
+			return (status >= HttpStatusCode::INTERNAL_SERVER_ERROR) ? CIRCUIT_FAILURE : CIRCUIT_SUCCESS;
+
+		case HttpErrorCode::KY_HTTP_COULDNT_RESOLVE_HOST:
+		case HttpErrorCode::KY_HTTP_COULDNT_CONNECT:
+		case HttpErrorCode::KY_HTTP_SSL_HANDSHAKE_FAIL:
+		case HttpErrorCode::KY_HTTP_SEND_ERROR:
+		case HttpErrorCode::KY_HTTP_RECV_ERROR:
+		case HttpErrorCode::KY_HTTP_REQUEST_TIMEOUT:
+			return CIRCUIT_FAILURE;
+
+		default:
+			return CIRCUIT_IGNORE; // local error, user stop : not a server health
+		}
+	}
+
+public:
+	/******************************************************************************
+	*! @brief  : permission to send a request (attempt) to origin
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	origin : scheme://host:port
+	*! @parameter:	probe : [out] TRUE : request is the half-open probe (give result by Report)
+	*! @return : TRUE : send / FALSE : circuit open (fail fast)
+	******************************************************************************/
+	BOOL Acquire(IN const std::string& origin, OUT BOOL& probe)
+	{
+		probe = FALSE;
+
+		CircuitSlot* slot = this->FindSlot(origin);
+		if (!slot)
+			return TRUE;
+
+		int state = slot->m_state.load(std::memory_order_acquire);
+		if (state == KY_HTTP_CIRCUIT_CLOSED)
+			return TRUE;
+
+		LONGLONG now = NowMs();
+		if (state == KY_HTTP_CIRCUIT_OPENED && now < slot->m_open_until.load(std::memory_order_relaxed))
+		{
+			m_reject_count.fetch_add(1, std::memory_order_relaxed);
+			return FALSE;
+		}
+
+		// one probe at a time, lost probe (no result) replaced after open time
+		LONGLONG probe_time = slot->m_probe_time.load(std::memory_order_acquire);
+		if ((probe_time == 0 || now - probe_time >= (LONGLONG)m_open_time) &&
+			slot->m_probe_time.compare_exchange_strong(probe_time, now))
+		{
+			if (state == KY_HTTP_CIRCUIT_OPENED &&
+				slot->m_state.compare_exchange_strong(state, KY_HTTP_CIRCUIT_HALF_OPEN))
+			{
+				KY_HTTP_LOG("[Circuit] %s : half-open, sending probe.", origin.c_str());
+			}
+
+			m_probe_count.fetch_add(1, std::memory_order_relaxed);
+			probe = TRUE;
+			return TRUE;
+		}
+
+		m_reject_count.fetch_add(1, std::memory_order_relaxed);
+		return FALSE;
+	}
+
+	/******************************************************************************
+	*! @brief  : result of an attempt sent with Acquire
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	retcode : ConvertCURLCodeToHTTPCode of the attempt
+	*! @parameter:	status : response status (0 : no response)
+	*! @parameter:	probe : value given by Acquire
+	*! @return : void
+	******************************************************************************/
+	void Report(IN const std::string& origin, IN HttpErrorCode retcode, IN LONG status, IN BOOL probe)
+	{
+		CircuitSlot* slot = this->FindSlot(origin);
+		if (!slot)
+			return;
+
+		CircuitResult result = this->Classify(retcode, status);
+		LONGLONG now = NowMs();
+
+		if (probe)
+		{
+			if (result == CIRCUIT_IGNORE)
+			{
+				slot->m_probe_time.store(0, std::memory_order_release);
+			}
+			else if (result == CIRCUIT_SUCCESS)
+			{
+				ClearBuckets(*slot);
+				slot->m_probe_time.store(0, std::memory_order_relaxed);
+				slot->m_state.store(KY_HTTP_CIRCUIT_CLOSED, std::memory_order_release);
+				KY_HTTP_LOG("[Circuit] %s : closed.", origin.c_str());
+			}
+			else
+			{
+				this->Open(*slot, KY_HTTP_CIRCUIT_HALF_OPEN, now, origin);
+			}
+			return;
+		}
+
+		if (result == CIRCUIT_IGNORE)
+			return;
+
+		this->Record(*slot, result == CIRCUIT_FAILURE, now);
+
+		if (result == CIRCUIT_FAILURE &&
+			slot->m_state.load(std::memory_order_acquire) == KY_HTTP_CIRCUIT_CLOSED &&
+			this->IsFailureRateExceeded(*slot, now))
+		{
+			this->Open(*slot, KY_HTTP_CIRCUIT_CLOSED, now, origin);
+		}
+	}
+
+	HttpCircuitState GetState(IN const std::string& origin)
+	{
+		CircuitSlot* slot = this->FindSlot(origin);
+		return slot ? (HttpCircuitState)slot->m_state.load(std::memory_order_acquire) : KY_HTTP_CIRCUIT_CLOSED;
+	}
+
+	HttpCircuitStats GetStats() const
+	{
+		HttpCircuitStats stats;
+		stats.m_open_count	 = m_open_count.load();
+		stats.m_reject_count = m_reject_count.load();
+		stats.m_probe_count	 = m_probe_count.load();
+		return stats;
+	}
+
+	/******************************************************************************
+	*! @brief  : breaker of process (shared by clients, state by origin)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : HttpCircuitBreakerPtr
+	******************************************************************************/
+	static HttpCircuitBreakerPtr Global()
+	{
+		static HttpCircuitBreakerPtr global_breaker = std::make_shared<HttpCircuitBreaker>();
+		return global_breaker;
+	}
+};
+
+__END___NAMESPACE__
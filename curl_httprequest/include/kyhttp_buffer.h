@@ -11,18 +11,42 @@
 #pragma once
 
 #include <memory>
-
+#include <cstring>
+#include <vector>
+
+#include "kyhttp_bufferpool.h"
+
+/*==================================================================================
+* Class HttpBuffer
+* Byte buffer : geometric growth (amortized O(1) append), untouched capacity is
+* not zeroed, small payload kept in inline storage (no heap allocation).
+* Heap memory is taken from / given back to HttpBufferPool.
+* Data is always followed by a '\0' (can read as C string).
+===================================================================================*/
 class HttpBuffer
 {
-	char*		 m_data;
-	unsigned int m_size;
-	unsigned int m_capacity;
+	enum { INLINE_CAPACITY = 64 };
+
+	char*		m_data;		// m_inline or heap memory
+	size_t		m_size;
+	size_t		m_capacity;	// not including terminator
+	char		m_inline[INLINE_CAPACITY + 1];
 
 public:
-	HttpBuffer() : m_data(nullptr),
-		m_size(0), m_capacity(0)
+	HttpBuffer() : m_data(m_inline),
+		m_size(0), m_capacity(INLINE_CAPACITY)
 	{
+		m_inline[0] = 0;
+	}
 
+	HttpBuffer(const HttpBuffer& other) : HttpBuffer()
+	{
+		this->set(other.m_data, other.m_size);
+	}
+
+	HttpBuffer(HttpBuffer&& other) noexcept : HttpBuffer()
+	{
+		this->move_from(other);
 	}
 
 	~HttpBuffer()
@@ -30,90 +54,119 @@ public:
 		this->_delete();
 	}
 
+	HttpBuffer& operator=(const HttpBuffer& other)
+	{
+		if (this != &other)
+		{
+			this->clear();
+			this->set(other.m_data, other.m_size);
+		}
+		return *this;
+	}
+
+	HttpBuffer& operator=(HttpBuffer&& other) noexcept
+	{
+		if (this != &other)
+		{
+			this->_delete();
+			this->move_from(other);
+		}
+		return *this;
+	}
+
 	void*  buffer() const { return m_data; }
 	size_t length() const { return m_size; }
+	size_t capacity() const { return m_capacity; }
 
 private:
+	bool is_inline() const
+	{
+		return m_data == m_inline;
+	}
+
 	/******************************************************************************
-	*! @brief     : delete memory 
+	*! @brief     : delete heap memory, back to inline storage
 	*! @parameter : void
 	*! @author    : thuong.nv - [Date] : 11/11/2022
 	******************************************************************************/
 	void _delete()
 	{
-		delete[] m_data;
-		m_size = 0;
-		m_capacity = 0;
+		if (!is_inline())
+		{
+			HttpBufferPool::Global().Free(m_data, m_capacity + 1);
+		}
+		m_data		= m_inline;
+		m_size		= 0;
+		m_capacity	= INLINE_CAPACITY;
+		m_inline[0] = 0;
 	}
 
-	void free()
+	void move_from(HttpBuffer& other)
 	{
-		if (m_data)
+		if (other.is_inline())
 		{
-			memset(m_data, 0, m_size);
+			memcpy(m_inline, other.m_inline, other.m_size + 1);
 		}
-		m_size = 0;
+		else
+		{
+			m_data		= other.m_data;
+			m_capacity	= other.m_capacity;
+		}
+		m_size = other.m_size;
+
+		other.m_data	  = other.m_inline;
+		other.m_size	  = 0;
+		other.m_capacity  = INLINE_CAPACITY;
+		other.m_inline[0] = 0;
 	}
 
 	/******************************************************************************
-	*! @brief     : allocate memory
-	*! @parameter : nsize : memory size
-	*! @parameter : cp    : copy old memory
+	*! @brief     : allocate memory (keep old data), only new data is written
+	*! @parameter : ncapacity : memory size (not including terminator)
 	*! @return : 1 : ok  / 0 : false
 	*! @author    : thuong.nv - [Date] : 11/11/2022
 	******************************************************************************/
-	int alloc(int nsize, bool cp = false)
+	int alloc(size_t ncapacity)
 	{
-		if (nsize <= m_capacity)
+		if (ncapacity <= m_capacity)
 			return 1;
 
-		char* m_olddata = m_data;
+		// pool can give bigger block : use all of it
+		size_t nblock = ncapacity + 1;
+		char* newdata = HttpBufferPool::Global().Allocate(nblock);
+		if (!newdata)
+			return 0;
 
-		m_data = new char[nsize];
-		memset(m_data, 0, nsize);
-		m_capacity = nsize;
+		memcpy(newdata, m_data, m_size + 1);
 
-		if (cp && m_olddata)
+		if (!is_inline())
 		{
-			memcpy_s(m_data, m_size, m_olddata, m_size);
+			HttpBufferPool::Global().Free(m_data, m_capacity + 1);
 		}
-		else
-		{
-			memset(m_data, 0, m_size);
-		}
-
-		delete[] m_olddata;
+		m_data	   = newdata;
+		m_capacity = nblock - 1;
 
 		return 1;
 	}
 
 	/******************************************************************************
-	*! @brief  : allocate memory - append to old memory
+	*! @brief  : allocate memory - append to old memory (grow x1.5 -> O(log n) allocations)
 	*! @parameter : nsize : memory size append
 	*! @return : 1 : ok  / 0 : false
 	*! @author : thuong.nv - [Date] : 11/11/2022
 	******************************************************************************/
-	int alloc_append(int nsize)
+	int alloc_append(size_t nsize)
 	{
-		int newsize = m_size + nsize;
+		size_t newsize = m_size + nsize;
 
 		if (newsize <= m_capacity)
 			return 1;
 
-		char* m_olddata = m_data;
-		m_capacity = newsize;
+		size_t newcapacity = m_capacity + m_capacity / 2;
+		if (newcapacity < newsize)
+			newcapacity = newsize;
 
-		m_data = new char[m_capacity];
-		memset(m_data, 0, m_capacity);
-
-#if defined(WIN32) || defined(WIN64)
-		memcpy_s(m_data, m_capacity, m_olddata, m_size);
-#else
-		strncpy(destination, source, count);
-#endif
-		delete[] m_olddata;
-
-		return 1;
+		return alloc(newcapacity);
 	}
 
 public:
@@ -146,52 +199,199 @@ public:
 		return &m_data[i];
 	}
 
-	int append(const void* data, unsigned int nsize)
+	size_t append(const void* data, size_t nsize)
 	{
 		if (nsize <= 0)
-			return 1;
+			return 0;
 
-		int alloc_ok = alloc_append(nsize + 2);
-		if (alloc_ok)
-		{
-			memcpy(m_data + m_size, data, nsize);
-			m_size += nsize;
-			return nsize;
-		}
-		return 0;
+		if (!alloc_append(nsize))
+			return 0;
+
+		memcpy(m_data + m_size, data, nsize);
+		m_size += nsize;
+		m_data[m_size] = 0;
+
+		return nsize;
+	}
+
+	size_t set(const void* data, size_t nsize)
+	{
+		m_size = 0;
+		m_data[0] = 0;
+
+		return this->append(data, nsize);
 	}
 
-	int set(const void* data, unsigned int nsize)
+	void reserve(size_t nsize)
 	{
 		if (nsize <= 0)
-			return 1;
+			return ;
+
+		alloc(nsize);
+	}
 
-		int alloc_ok = alloc(nsize + 2, false);
-		if (alloc_ok)
+	// set length, new bytes are not initialized (written by caller. Ex: compressor output)
+	bool resize(size_t nsize)
+	{
+		if (nsize > m_size && !alloc_append(nsize - m_size))
+			return false;
+
+		m_size = nsize;
+		m_data[m_size] = 0;
+		return true;
+	}
+
+	bool empty() const
+	{
+		return m_size <= 0 ? true : false;
+	}
+
+	// keep capacity for next use
+	void clear()
+	{
+		m_size = 0;
+		m_data[0] = 0;
+	}
+
+	// free heap memory
+	void release()
+	{
+		this->_delete();
+	}
+};
+
+// contiguous part of SegmentedHttpBuffer
+struct HttpSegment
+{
+	const char*	m_data;
+	size_t		m_size;
+};
+
+/*==================================================================================
+* Class SegmentedHttpBuffer
+* Rope of fixed-size chunks (HttpBufferPool) : append never moves received data.
+* Read by segments (zero copy) or Flatten() when contiguous memory is needed.
+*
+* Ex: for (auto segment : buffer) { fwrite(segment.m_data, 1, segment.m_size, file); }
+===================================================================================*/
+class SegmentedHttpBuffer
+{
+public:
+	static const size_t CHUNK_SIZE = 64 * 1024;
+
+private:
+	std::vector<char*>	m_chunks;
+	size_t				m_size;
+
+public:
+	class const_iterator
+	{
+		const SegmentedHttpBuffer*	m_buffer;
+		size_t						m_index;
+
+	public:
+		const_iterator(const SegmentedHttpBuffer* buffer, size_t index) :
+			m_buffer(buffer), m_index(index)
 		{
-			memcpy(m_data, data, nsize);
 
-			m_size = nsize;
-			return nsize;
 		}
-		return 0;
+
+		HttpSegment operator*() const { return m_buffer->segment(m_index); }
+		const_iterator& operator++() { m_index++; return *this; }
+		bool operator==(const const_iterator& other) const { return m_index == other.m_index; }
+		bool operator!=(const const_iterator& other) const { return m_index != other.m_index; }
+	};
+
+public:
+	SegmentedHttpBuffer() : m_size(0)
+	{
+
 	}
 
-	void reserve(unsigned int nsize)
+	~SegmentedHttpBuffer()
 	{
-		if (nsize <= 0)
-			return ;
+		this->clear();
+	}
+
+	SegmentedHttpBuffer(const SegmentedHttpBuffer&) = delete;
+	SegmentedHttpBuffer& operator=(const SegmentedHttpBuffer&) = delete;
 
-		alloc(nsize, true);
+	SegmentedHttpBuffer(SegmentedHttpBuffer&& other) noexcept :
+		m_chunks(std::move(other.m_chunks)), m_size(other.m_size)
+	{
+		other.m_chunks.clear();
+		other.m_size = 0;
 	}
 
-	bool empty()
+	size_t length() const { return m_size; }
+	bool   empty() const { return m_size <= 0; }
+
+	size_t segment_count() const { return m_chunks.size(); }
+
+	HttpSegment segment(size_t i) const
 	{
-		return m_size <= 0 ? true : false;
+		size_t offset = i * CHUNK_SIZE;
+		size_t nsize  = (m_size - offset < CHUNK_SIZE) ? m_size - offset : CHUNK_SIZE;
+
+		return { m_chunks[i], nsize };
 	}
 
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, m_chunks.size()); }
+
+	size_t append(const void* data, size_t nsize)
+	{
+		const char* src = static_cast<const char*>(data);
+		size_t remain = nsize;
+
+		while (remain > 0)
+		{
+			size_t used = m_size % CHUNK_SIZE;
+
+			// last chunk full (or no chunk)
+			if (used == 0 && m_size == m_chunks.size() * CHUNK_SIZE)
+			{
+				size_t nchunk = CHUNK_SIZE;
+				char* chunk = HttpBufferPool::Global().Allocate(nchunk);
+				if (!chunk)
+					break;
+				m_chunks.push_back(chunk);
+			}
+
+			size_t ncopy = CHUNK_SIZE - used;
+			if (ncopy > remain)
+				ncopy = remain;
+
+			memcpy(m_chunks.back() + used, src, ncopy);
+			src		+= ncopy;
+			remain	-= ncopy;
+			m_size	+= ncopy;
+		}
+
+		return nsize - remain;
+	}
+
+	// copy to contiguous memory
+	HttpBuffer Flatten() const
+	{
+		HttpBuffer out;
+		out.reserve(m_size);
+
+		for (auto segment : *this)
+		{
+			out.append(segment.m_data, segment.m_size);
+		}
+		return out;
+	}
+
+	// chunks back to pool
 	void clear()
 	{
-		this->free();
+		for (auto chunk : m_chunks)
+		{
+			HttpBufferPool::Global().Free(chunk, CHUNK_SIZE);
+		}
+		m_chunks.clear();
+		m_size = 0;
 	}
 };
@@ -0,0 +1,358 @@
+/*!**********************************************************************
+* @copyright Copyright (C) 2022 thuong.nv -email: mark.ngo@kohyoung.com.\n
+*            All rights reserved.
+*************************************************************************
+* @file     kyhttp_bufferpool.h
+* @date     Oct 17, 2026
+* @brief    HTTP client libcurl implementation file.
+*
+** Size-class memory pool for HttpBuffer (recycled between requests)
+*************************************************************************/
+#pragma once
+
+#include <new>
+#include <atomic>
+#include <cstddef>
+
+struct HttpBufferPoolStats
+{
+	unsigned long long	m_alloc_count;		// number of Allocate
+	unsigned long long	m_hit_count;		// served from thread cache or depot (no malloc)
+	unsigned long long	m_miss_count;		// new[] called
+	unsigned long long	m_retained_bytes;	// free memory kept by the pool
+
+	double hit_rate() const
+	{
+		return m_alloc_count > 0 ? (double)m_hit_count / (double)m_alloc_count : 0.0;
+	}
+};
+
+/*==================================================================================
+* Class HttpBufferPool
+* Blocks of power of two size [256 B -> 8 MB], bigger is new[] / delete[] directly.
+*
+* Thread cache : each thread keeps a few free blocks per size class (no lock, no atomic)
+* Depot		   : per size class, fixed slots of batches (intrusive list of blocks).
+*				 full cache -> put half of it to an empty slot (CAS from null)
+*				 empty cache -> take a whole batch (exchange with null)
+*				 a batch is owned by one thread at a time -> no ABA problem
+*
+* Pool is never destroyed (buffer with static storage can free after main exit).
+===================================================================================*/
+class HttpBufferPool
+{
+public:
+	enum
+	{
+		MIN_CLASS_SHIFT	 = 8,		// 256 B
+		MAX_CLASS_SHIFT	 = 23,		// 8 MB
+		NUM_CLASS		 = MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1,
+		NUM_DEPOT_SLOT	 = 16,		// batches per size class
+		THREAD_CACHE_BYTES = 512 * 1024,	// per size class per thread
+		MAX_THREAD_CACHE = 64,
+	};
+
+private:
+	// free block : first bytes used as list node
+	struct FreeBlock
+	{
+		FreeBlock*	m_next;
+		size_t		m_count;	// head of batch : number of blocks
+	};
+
+	struct ThreadCache
+	{
+		FreeBlock*	m_head[NUM_CLASS];
+		size_t		m_count[NUM_CLASS];
+	};
+
+	// flush thread cache to depot when thread exits
+	struct ThreadCacheGuard
+	{
+		ThreadCache m_cache;
+
+		ThreadCacheGuard();
+		~ThreadCacheGuard();
+	};
+
+private:
+	std::atomic<FreeBlock*>				m_depot[NUM_CLASS][NUM_DEPOT_SLOT];
+
+	std::atomic<unsigned long long>		m_alloc_count;
+	std::atomic<unsigned long long>		m_hit_count;
+	std::atomic<unsigned long long>		m_miss_count;
+	std::atomic<long long>				m_retained_bytes;
+
+private:
+	HttpBufferPool() : m_alloc_count(0), m_hit_count(0), m_miss_count(0), m_retained_bytes(0)
+	{
+		for (int i = 0; i < NUM_CLASS; i++)
+		{
+			for (int j = 0; j < NUM_DEPOT_SLOT; j++)
+			{
+				m_depot[i][j].store(nullptr, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	static int size_class(size_t nsize)
+	{
+		int shift = MIN_CLASS_SHIFT;
+		while (shift <= MAX_CLASS_SHIFT && (size_t(1) << shift) < nsize)
+		{
+			shift++;
+		}
+		return shift - MIN_CLASS_SHIFT; // NUM_CLASS : over max class
+	}
+
+	static size_t class_size(int index)
+	{
+		return size_t(1) << (index + MIN_CLASS_SHIFT);
+	}
+
+	static size_t thread_cache_limit(int index)
+	{
+		size_t limit = THREAD_CACHE_BYTES / class_size(index);
+		if (limit < 2) limit = 2;
+		if (limit > MAX_THREAD_CACHE) limit = MAX_THREAD_CACHE;
+
+		return limit;
+	}
+
+	// 0 : not init | 1 : alive | 2 : thread exiting (cache destroyed)
+	static int& thread_cache_state()
+	{
+		static thread_local int state = 0;
+		return state;
+	}
+
+	static ThreadCache* thread_cache()
+	{
+		static thread_local ThreadCache* cache = nullptr;
+
+		int& state = thread_cache_state();
+		if (state == 0)
+		{
+			static thread_local ThreadCacheGuard guard;
+			cache = &guard.m_cache;
+		}
+		return state == 1 ? cache : nullptr;
+	}
+
+	// take one batch of the size class from depot
+	FreeBlock* depot_pop(int index)
+	{
+		for (int i = 0; i < NUM_DEPOT_SLOT; i++)
+		{
+			if (m_depot[index][i].load(std::memory_order_relaxed) == nullptr)
+				continue;
+
+			FreeBlock* batch = m_depot[index][i].exchange(nullptr, std::memory_order_acquire);
+			if (batch)
+				return batch;
+		}
+		return nullptr;
+	}
+
+	// FALSE : depot full
+	bool depot_push(int index, FreeBlock* batch)
+	{
+		for (int i = 0; i < NUM_DEPOT_SLOT; i++)
+		{
+			FreeBlock* expected = nullptr;
+			if (m_depot[index][i].compare_exchange_strong(expected, batch, std::memory_order_release,
+														  std::memory_order_relaxed))
+				return true;
+		}
+		return false;
+	}
+
+	void delete_list(int index, FreeBlock* head)
+	{
+		while (head)
+		{
+			FreeBlock* next = head->m_next;
+			m_retained_bytes.fetch_sub((long long)class_size(index), std::memory_order_relaxed);
+			delete[] reinterpret_cast<char*>(head);
+			head = next;
+		}
+	}
+
+	// move n blocks of thread cache to depot (or free if depot is full)
+	void flush_thread_cache(ThreadCache* cache, int index, size_t n)
+	{
+		if (n <= 0 || !cache->m_head[index])
+			return;
+
+		FreeBlock* head = cache->m_head[index];
+		FreeBlock* tail = head;
+		size_t count = 1;
+
+		while (count < n && tail->m_next)
+		{
+			tail = tail->m_next;
+			count++;
+		}
+
+		cache->m_head[index]   = tail->m_next;
+		cache->m_count[index] -= count;
+
+		tail->m_next  = nullptr;
+		head->m_count = count;
+
+		if (!depot_push(index, head))
+		{
+			delete_list(index, head);
+		}
+	}
+
+public:
+	static HttpBufferPool& Global()
+	{
+		static HttpBufferPool* pool = new HttpBufferPool();
+		return *pool;
+	}
+
+	/******************************************************************************
+	*! @brief  : allocate memory block
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	nsize : [in] request size / [out] real size of block (>= request)
+	*! @return : memory block / nullptr : out of memory
+	******************************************************************************/
+	char* Allocate(size_t& nsize)
+	{
+		m_alloc_count.fetch_add(1, std::memory_order_relaxed);
+
+		int index = size_class(nsize);
+		if (index >= NUM_CLASS)
+		{
+			m_miss_count.fetch_add(1, std::memory_order_relaxed);
+			return new (std::nothrow) char[nsize];
+		}
+
+		nsize = class_size(index);
+
+		ThreadCache* cache = thread_cache();
+		if (cache)
+		{
+			// refill from depot
+			if (!cache->m_head[index])
+			{
+				FreeBlock* batch = depot_pop(index);
+				if (batch)
+				{
+					cache->m_head[index]  = batch;
+					cache->m_count[index] = batch->m_count;
+				}
+			}
+
+			FreeBlock* block = cache->m_head[index];
+			if (block)
+			{
+				cache->m_head[index] = block->m_next;
+				cache->m_count[index]--;
+
+				m_hit_count.fetch_add(1, std::memory_order_relaxed);
+				m_retained_bytes.fetch_sub((long long)nsize, std::memory_order_relaxed);
+				return reinterpret_cast<char*>(block);
+			}
+		}
+		else
+		{
+			// thread exiting : take one block of a batch, give back the rest
+			FreeBlock* batch = depot_pop(index);
+			if (batch)
+			{
+				if (batch->m_next)
+				{
+					batch->m_next->m_count = batch->m_count - 1;
+					if (!depot_push(index, batch->m_next))
+						delete_list(index, batch->m_next);
+				}
+
+				m_hit_count.fetch_add(1, std::memory_order_relaxed);
+				m_retained_bytes.fetch_sub((long long)nsize, std::memory_order_relaxed);
+				return reinterpret_cast<char*>(batch);
+			}
+		}
+
+		m_miss_count.fetch_add(1, std::memory_order_relaxed);
+		return new (std::nothrow) char[nsize];
+	}
+
+	/******************************************************************************
+	*! @brief  : give back memory block
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	nsize : real size returned by Allocate
+	*! @return : void
+	******************************************************************************/
+	void Free(char* data, size_t nsize)
+	{
+		if (!data)
+			return;
+
+		int index = size_class(nsize);
+		if (index >= NUM_CLASS || class_size(index) != nsize)
+		{
+			delete[] data;
+			return;
+		}
+
+		FreeBlock* block = reinterpret_cast<FreeBlock*>(data);
+		m_retained_bytes.fetch_add((long long)nsize, std::memory_order_relaxed);
+
+		ThreadCache* cache = thread_cache();
+		if (!cache)
+		{
+			block->m_next  = nullptr;
+			block->m_count = 1;
+			if (!depot_push(index, block))
+				delete_list(index, block);
+			return;
+		}
+
+		block->m_next = cache->m_head[index];
+		cache->m_head[index] = block;
+		cache->m_count[index]++;
+
+		size_t limit = thread_cache_limit(index);
+		if (cache->m_count[index] > limit)
+		{
+			flush_thread_cache(cache, index, (limit + 1) / 2);
+		}
+	}
+
+	HttpBufferPoolStats GetStats() const
+	{
+		HttpBufferPoolStats stats;
+		stats.m_alloc_count	   = m_alloc_count.load(std::memory_order_relaxed);
+		stats.m_hit_count	   = m_hit_count.load(std::memory_order_relaxed);
+		stats.m_miss_count	   = m_miss_count.load(std::memory_order_relaxed);
+
+		long long retained	   = m_retained_bytes.load(std::memory_order_relaxed);
+		stats.m_retained_bytes = retained > 0 ? (unsigned long long)retained : 0;
+
+		return stats;
+	}
+};
+
+inline HttpBufferPool::ThreadCacheGuard::ThreadCacheGuard()
+{
+	for (int i = 0; i < NUM_CLASS; i++)
+	{
+		m_cache.m_head[i]  = nullptr;
+		m_cache.m_count[i] = 0;
+	}
+	thread_cache_state() = 1;
+}
+
+inline HttpBufferPool::ThreadCacheGuard::~ThreadCacheGuard()
+{
+	thread_cache_state() = 2;
+
+	HttpBufferPool& pool = HttpBufferPool::Global();
+	for (int i = 0; i < NUM_CLASS; i++)
+	{
+		pool.flush_thread_cache(&m_cache, i, m_cache.m_count[i]);
+	}
+}
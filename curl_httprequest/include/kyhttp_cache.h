@@ -0,0 +1,616 @@
+/*!**********************************************************************
+* @copyright Copyright (C) 2022 thuong.nv -email: mark.ngo@kohyoung.com.\n
+*            All rights reserved.
+*************************************************************************
+* @file     kyhttp_cache.h
+* @date     Oct 17, 2026
+* @brief    HTTP client libcurl implementation file.
+*
+** In-memory HTTP response cache (RFC 7234 private cache, LRU by bytes)
+*************************************************************************/
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <ctime>
+#include <functional>
+#include <unordered_map>
+#include <Windows.h>
+
+#include "kyhttp_types.h"
+#include "kyhttp_utils.h"
+#include "kyhttp_buffer.h"
+#include "kyhttp_header.h"
+#include "kyhttp_logger.h"
+
+__BEGIN_NAMESPACE__
+
+class HttpCache;
+typedef std::shared_ptr<HttpCache> HttpCachePtr;
+
+struct HttpCacheEntry;
+typedef std::shared_ptr<const HttpCacheEntry> HttpCacheEntryPtr;
+
+interface IHttpCacheStore;
+typedef std::shared_ptr<IHttpCacheStore> HttpCacheStorePtr;
+
+// value of request header by name (Vary)
+typedef std::function<std::string(const std::string&)> HttpRequestHeaderFunc;
+
+struct HttpCacheStats
+{
+	unsigned long long	m_hit_count;			// fresh entry served, no transfer
+	unsigned long long	m_miss_count;			// no usable entry
+	unsigned long long	m_revalidate_count;		// conditional request sent (stale entry)
+	unsigned long long	m_not_modified_count;	// 304 received -> entry served
+	unsigned long long	m_store_count;
+	unsigned long long	m_evict_count;
+	unsigned long long	m_store_load_count;		// entry loaded from attached store (memory miss)
+	size_t				m_entry_count;
+	size_t				m_bytes;
+};
+
+/*==================================================================================
+* struct HttpCacheEntry
+* Stored response (immutable : replaced when refreshed, readers keep their copy)
+===================================================================================*/
+struct HttpCacheEntry
+{
+	std::string			m_key;
+	LONG				m_status;
+	std::shared_ptr<const HttpBuffer> m_header;		// header of last hop
+
+	// body : memory owned by m_content_owner (HttpBuffer, mapped segment of store)
+	// shared with refreshed entry
+	std::shared_ptr<const void> m_content_owner;
+	const char*			m_content_data;
+	size_t				m_content_size;
+
+	std::string			m_etag;				// If-None-Match
+	std::string			m_last_modified;	// If-Modified-Since
+	std::vector<std::pair<std::string, std::string>> m_vary; // request header -> value when stored
+
+	time_t				m_stored_time;
+	time_t				m_fresh_until;		// second epoch
+	BOOL				m_no_cache;			// Cache-Control: no-cache -> revalidate every time
+
+	HttpCacheEntry() : m_status(0), m_content_data(NULL), m_content_size(0),
+		m_stored_time(0), m_fresh_until(0), m_no_cache(FALSE)
+	{
+
+	}
+
+	BOOL IsFresh(IN time_t now) const
+	{
+		return !m_no_cache && now < m_fresh_until;
+	}
+
+	BOOL HasValidator() const
+	{
+		return !m_etag.empty() || !m_last_modified.empty();
+	}
+
+	size_t size() const
+	{
+		return m_key.size() + (m_header ? m_header->length() : 0) + m_content_size;
+	}
+};
+
+/*==================================================================================
+* interface IHttpCacheStore
+* Second level of HttpCache (persistent) : memory miss -> Load, stored / refreshed
+* entry -> Save / Update. Called without the lock of HttpCache.
+===================================================================================*/
+interface IHttpCacheStore
+{
+	virtual ~IHttpCacheStore() {}
+
+	virtual HttpCacheEntryPtr	Load(IN const std::string& key) = 0;	// nullptr : not found
+	virtual BOOL				Save(IN const HttpCacheEntry& entry) = 0;
+	virtual BOOL				Update(IN const HttpCacheEntry& entry) = 0; // freshness / validators refreshed by 304
+	virtual void				Remove(IN const std::string& key) = 0;
+
+	// Vary names of key : variants are saved under key + values -> names kept to find them
+	// after restart (empty names : remove). Store without it : variants found in memory only
+	virtual BOOL SaveVary(IN const std::string& key, IN const std::vector<std::string>& names)
+	{
+		(void)key; (void)names;
+		return FALSE;
+	}
+
+	virtual std::vector<std::string> LoadVary(IN const std::string& key)
+	{
+		(void)key;
+		return std::vector<std::string>();
+	}
+};
+
+/*==================================================================================
+* Class HttpCache
+* Attach to HttpClient (AttachCache) : GET responses kept in memory, evicted by
+* least recently used when total size is over limit.
+*
+* Fresh entry			 -> served without transfer
+* Stale entry + ETag/LM  -> conditional request, 304 -> served from cache
+* Vary					 -> one entry by variant : key + values of Vary request headers
+*						    (Vary names of URL learned from its last response)
+* Safe for clients running on different threads.
+===================================================================================*/
+class HttpCache
+{
+private:
+	typedef std::list<HttpCacheEntryPtr> LruList;
+
+	enum { MAX_VARY_KEYS = 4096 };
+
+	std::mutex			m_lock;
+	LruList				m_lru;			// front : most recently used
+	std::unordered_map<std::string, LruList::iterator> m_index;		// variant key -> entry
+	std::unordered_map<std::string, std::vector<std::string>> m_vary_names; // key -> Vary of last response
+
+	size_t				m_max_bytes;
+	size_t				m_max_entry_bytes;
+	HttpCacheStats		m_stats;
+	HttpCacheStorePtr	m_store;
+
+public:
+	HttpCache(IN size_t max_bytes = 64 * 1024 * 1024, IN size_t max_entry_bytes = 0) :
+		m_max_bytes(max_bytes),
+		m_max_entry_bytes(max_entry_bytes > 0 ? max_entry_bytes : max_bytes / 8),
+		m_store(nullptr)
+	{
+		memset(&m_stats, 0, sizeof(m_stats));
+	}
+
+	HttpCache(const HttpCache&) = delete;
+	HttpCache& operator=(const HttpCache&) = delete;
+
+private:
+	static bool equal_nocase(const std::string& a, const std::string& b)
+	{
+		if (a.size() != b.size())
+			return false;
+
+		for (size_t i = 0; i < a.size(); i++)
+		{
+			if (tolower((unsigned char)a[i]) != tolower((unsigned char)b[i]))
+				return false;
+		}
+		return true;
+	}
+
+	// split "a, b, c" (comma list header)
+	static std::vector<std::string> split_list(IN const HttpHeaderValue& value)
+	{
+		std::vector<std::string> items;
+		std::string item;
+
+		for (size_t i = 0; i <= value.m_size; i++)
+		{
+			char c = (i < value.m_size) ? value.m_data[i] : ',';
+			if (c == ',')
+			{
+				size_t begin = item.find_first_not_of(" \t");
+				size_t end	 = item.find_last_not_of(" \t");
+				if (begin != std::string::npos)
+					items.push_back(item.substr(begin, end - begin + 1));
+				item.clear();
+			}
+			else
+			{
+				item.push_back(c);
+			}
+		}
+		return items;
+	}
+
+	static time_t header_time(IN const HttpHeaderTable& table, IN const char* name, IN time_t defval)
+	{
+		time_t time = 0;
+		HttpHeaderValue value = table.GetHeader(name);
+		return (value && kyhttp::parse_http_date(value.m_data, value.m_size, time)) ? time : defval;
+	}
+
+	/******************************************************************************
+	*! @brief  : freshness of response (RFC 7234 4.2)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	no_store : [out] Cache-Control: no-store
+	*! @parameter:	no_cache : [out] Cache-Control: no-cache
+	*! @return : second epoch the response is fresh until
+	******************************************************************************/
+	static time_t compute_fresh_until(IN const HttpHeaderTable& table, IN time_t now,
+									  OUT BOOL& no_store, OUT BOOL& no_cache)
+	{
+		no_store = FALSE;
+		no_cache = FALSE;
+
+		long long max_age = -1;
+		for (auto value : table.GetHeaders("Cache-Control"))
+		{
+			for (auto& directive : split_list(value))
+			{
+				std::string name = directive.substr(0, directive.find('='));
+				if (equal_nocase(name, "no-store"))
+					no_store = TRUE;
+				else if (equal_nocase(name, "no-cache"))
+					no_cache = TRUE;
+				else if (equal_nocase(name, "max-age") && name.size() < directive.size())
+					max_age = atoll(directive.c_str() + name.size() + 1);
+			}
+		}
+
+		// Pragma: no-cache (HTTP/1.0)
+		HttpHeaderValue pragma = table.GetHeader("Pragma");
+		if (pragma && pragma.str().find("no-cache") != std::string::npos)
+			no_cache = TRUE;
+
+		time_t date = header_time(table, "Date", now);
+
+		// age of response when received
+		long long age = (now > date) ? (long long)(now - date) : 0;
+		HttpHeaderValue age_value = table.GetHeader("Age");
+		if (age_value)
+		{
+			long long header_age = atoll(age_value.str().c_str());
+			if (header_age > age) age = header_age;
+		}
+
+		long long lifetime = 0;
+		if (max_age >= 0)
+		{
+			lifetime = max_age;
+		}
+		else if (table.GetHeader("Expires"))
+		{
+			// invalid date -> already expired
+			time_t expires = header_time(table, "Expires", 0);
+			lifetime = (expires > date) ? (long long)(expires - date) : 0;
+		}
+		else
+		{
+			// heuristic : 10% of time since last modified
+			time_t last_modified = header_time(table, "Last-Modified", 0);
+			if (last_modified > 0 && date > last_modified)
+				lifetime = (long long)(date - last_modified) / 10;
+		}
+
+		return now + (time_t)(lifetime > age ? lifetime - age : 0);
+	}
+
+	// key + selected request header values : variants of same URL are separate entries
+	static std::string variant_key(IN const std::string& key, IN const std::vector<std::string>& names,
+								   IN const HttpRequestHeaderFunc& header_func)
+	{
+		std::string variant = key;
+		for (auto& name : names)
+		{
+			variant.append("\n").append(name).append(": ");
+			if (header_func)
+				variant.append(header_func(name));
+		}
+		return variant;
+	}
+
+	// lock held
+	std::string find_variant_key(IN const std::string& key, IN const HttpRequestHeaderFunc& header_func) const
+	{
+		auto it = m_vary_names.find(key);
+		return (it != m_vary_names.end()) ? variant_key(key, it->second, header_func) : key;
+	}
+
+	// lock held : Vary names of key learned from response (or from store) | TRUE : changed
+	BOOL set_vary_names(IN const std::string& key, IN const std::vector<std::string>& vary_names)
+	{
+		auto it = m_vary_names.find(key);
+		if (vary_names.empty())
+		{
+			if (it == m_vary_names.end())
+				return FALSE;
+
+			m_vary_names.erase(it);
+			return TRUE;
+		}
+
+		if (it != m_vary_names.end() && it->second == vary_names)
+			return FALSE;
+
+		// names only select the key : forgetting them costs a miss (store keeps them)
+		if (m_vary_names.size() >= MAX_VARY_KEYS && it == m_vary_names.end())
+			m_vary_names.clear();
+
+		m_vary_names[key] = vary_names;
+		return TRUE;
+	}
+
+	static BOOL match_vary(IN const HttpCacheEntry& entry, IN const HttpRequestHeaderFunc& header_func)
+	{
+		for (auto& vary : entry.m_vary)
+		{
+			std::string value = header_func ? header_func(vary.first) : std::string();
+			if (value != vary.second)
+				return FALSE;
+		}
+		return TRUE;
+	}
+
+	// lock held
+	void insert_entry(IN HttpCacheEntryPtr entry)
+	{
+		auto it = m_index.find(entry->m_key);
+		if (it != m_index.end())
+		{
+			m_stats.m_bytes -= (*it->second)->size();
+			m_lru.erase(it->second);
+			m_index.erase(it);
+		}
+
+		m_lru.push_front(entry);
+		m_index[entry->m_key] = m_lru.begin();
+		m_stats.m_bytes += entry->size();
+
+		// evict least recently used
+		while (m_stats.m_bytes > m_max_bytes && m_lru.size() > 1)
+		{
+			HttpCacheEntryPtr last = m_lru.back();
+			m_stats.m_bytes -= last->size();
+			m_index.erase(last->m_key);
+			m_lru.pop_back();
+			m_stats.m_evict_count++;
+		}
+		m_stats.m_entry_count = m_lru.size();
+	}
+
+public:
+	/******************************************************************************
+	*! @brief  : find entry of request (fresh or stale)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	key : method + url
+	*! @parameter:	header_func : value of request header (Vary)
+	*! @return : entry of the variant / nullptr : not found
+	******************************************************************************/
+	HttpCacheEntryPtr Lookup(IN const std::string& key, IN const HttpRequestHeaderFunc& header_func)
+	{
+		HttpCacheStorePtr store;
+		std::string variant;
+		BOOL vary_known = FALSE;
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+
+			vary_known = m_vary_names.count(key) ? TRUE : FALSE;
+			variant = this->find_variant_key(key, header_func);
+			auto it = m_index.find(variant);
+			if (it != m_index.end())
+			{
+				if (!match_vary(**it->second, header_func))
+					return nullptr;
+
+				m_lru.splice(m_lru.begin(), m_lru, it->second);
+				return *it->second;
+			}
+			store = m_store;
+		}
+
+		// Vary names not in memory (restart) : saved with key by store
+		if (store && !vary_known)
+		{
+			std::vector<std::string> vary_names = store->LoadVary(key);
+			if (!vary_names.empty())
+			{
+				variant = variant_key(key, vary_names, header_func);
+
+				std::lock_guard<std::mutex> lock(m_lock);
+				if (!m_vary_names.count(key))
+					this->set_vary_names(key, vary_names);
+			}
+		}
+
+		// memory miss -> persistent store (body stays in store memory)
+		HttpCacheEntryPtr entry = store ? store->Load(variant) : nullptr;
+		if (!entry || !match_vary(*entry, header_func))
+			return nullptr;
+
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_stats.m_store_load_count++;
+
+		if (entry->size() <= m_max_entry_bytes)
+			this->insert_entry(entry);
+
+		return entry;
+	}
+
+	/******************************************************************************
+	*! @brief  : store response (200) if cacheable
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	key : method + url (entry key adds values of Vary request headers)
+	*! @parameter:	header : header of response (last hop from table.hop_offset())
+	*! @return : stored entry / nullptr : not cacheable
+	******************************************************************************/
+	HttpCacheEntryPtr Store(IN const std::string& key, IN LONG status,
+							IN const HttpBuffer& header, IN const HttpHeaderTable& table,
+							IN const HttpBuffer& content, IN const HttpRequestHeaderFunc& header_func)
+	{
+		if (status != HttpStatusCode::SUCCESS)
+			return nullptr;
+
+		time_t now = time(NULL);
+
+		auto entry = std::make_shared<HttpCacheEntry>();
+		entry->m_status		 = status;
+		entry->m_stored_time = now;
+
+		BOOL no_store = FALSE;
+		entry->m_fresh_until = compute_fresh_until(table, now, no_store, entry->m_no_cache);
+		if (no_store)
+			return nullptr;
+
+		entry->m_etag		   = table.GetHeader("ETag").str();
+		entry->m_last_modified = table.GetHeader("Last-Modified").str();
+
+		// nothing to serve without a transfer
+		if (!entry->HasValidator() && !entry->IsFresh(now))
+			return nullptr;
+
+		std::vector<std::string> vary_names;
+		for (auto value : table.GetHeaders("Vary"))
+		{
+			for (auto name : split_list(value))
+			{
+				if (name == "*")
+					return nullptr;
+
+				// header names are case-insensitive : same variant key for any case
+				for (auto& c : name)
+					c = (char)tolower((unsigned char)c);
+
+				entry->m_vary.push_back(std::make_pair(name, header_func ? header_func(name) : std::string()));
+				vary_names.push_back(name);
+			}
+		}
+		entry->m_key = variant_key(key, vary_names, header_func);
+
+		size_t hop_offset = table.hop_offset();
+		auto header_copy = std::make_shared<HttpBuffer>();
+		header_copy->set((const char*)header.buffer() + hop_offset, header.length() - hop_offset);
+
+		auto content_copy = std::make_shared<HttpBuffer>(content);
+
+		entry->m_header			= header_copy;
+		entry->m_content_owner	= content_copy;
+		entry->m_content_data	= (const char*)content_copy->buffer();
+		entry->m_content_size	= content_copy->length();
+
+		HttpCacheStorePtr store;
+		BOOL vary_changed = FALSE;
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			store = m_store;
+
+			vary_changed = this->set_vary_names(key, vary_names);
+
+			// too large for memory : only kept by store
+			if (entry->size() > m_max_entry_bytes && !store)
+				return nullptr;
+
+			if (entry->size() <= m_max_entry_bytes)
+				this->insert_entry(entry);
+
+			m_stats.m_store_count++;
+		}
+
+		if (store)
+		{
+			if (vary_changed)
+				store->SaveVary(key, vary_names);
+			store->Save(*entry);
+		}
+
+		return entry;
+	}
+
+	/******************************************************************************
+	*! @brief  : update freshness of entry by 304 response
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	table : header of 304 response
+	*! @return : refreshed entry (same body)
+	******************************************************************************/
+	HttpCacheEntryPtr Refresh(IN HttpCacheEntryPtr entry, IN const HttpHeaderTable& table)
+	{
+		time_t now = time(NULL);
+
+		auto refreshed = std::make_shared<HttpCacheEntry>(*entry);
+		refreshed->m_stored_time = now;
+
+		BOOL no_store = FALSE;
+		refreshed->m_fresh_until = compute_fresh_until(table, now, no_store, refreshed->m_no_cache);
+
+		HttpHeaderValue etag = table.GetHeader("ETag");
+		if (etag)
+			refreshed->m_etag = etag.str();
+
+		HttpHeaderValue last_modified = table.GetHeader("Last-Modified");
+		if (last_modified)
+			refreshed->m_last_modified = last_modified.str();
+
+		HttpCacheStorePtr store;
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			m_stats.m_not_modified_count++;
+			store = m_store;
+
+			if (no_store)
+				this->Remove(entry->m_key, FALSE);
+			else if (refreshed->size() <= m_max_entry_bytes)
+				this->insert_entry(refreshed);
+		}
+
+		if (store)
+		{
+			if (no_store)
+				store->Remove(entry->m_key);
+			else
+				store->Update(*refreshed);
+		}
+		return refreshed;
+	}
+
+	void Remove(IN const std::string& key, IN BOOL lock_cache = TRUE)
+	{
+		std::unique_lock<std::mutex> lock(m_lock, std::defer_lock);
+		if (lock_cache)
+			lock.lock();
+
+		auto it = m_index.find(key);
+		if (it != m_index.end())
+		{
+			m_stats.m_bytes -= (*it->second)->size();
+			m_lru.erase(it->second);
+			m_index.erase(it);
+			m_stats.m_entry_count = m_lru.size();
+		}
+
+		if (lock_cache && m_store)
+		{
+			HttpCacheStorePtr store = m_store;
+			lock.unlock();
+			store->Remove(key);
+		}
+	}
+
+	/******************************************************************************
+	*! @brief  : attach persistent store (HttpDiskCache) behind memory | nullptr = detach
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : void
+	*! @note   : memory is the first level, store keeps entries too large for memory
+	******************************************************************************/
+	void AttachStore(IN HttpCacheStorePtr store)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_store = store;
+	}
+
+	// memory only (store is kept)
+	void Clear()
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_lru.clear();
+		m_index.clear();
+		m_stats.m_bytes		  = 0;
+		m_stats.m_entry_count = 0;
+	}
+
+	// counters updated by HttpClient
+	void CountHit()			{ std::lock_guard<std::mutex> lock(m_lock); m_stats.m_hit_count++; }
+	void CountMiss()		{ std::lock_guard<std::mutex> lock(m_lock); m_stats.m_miss_count++; }
+	void CountRevalidate()	{ std::lock_guard<std::mutex> lock(m_lock); m_stats.m_revalidate_count++; }
+
+	HttpCacheStats GetStats()
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		return m_stats;
+	}
+};
+
+__END___NAMESPACE__
@@ -13,14 +13,30 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <map>
+#include <list>
 #include <iomanip>
 #include <chrono>
 #include <sstream>
+#include <mutex>
+#include <thread>
 #include <ctime>
 #include <curl/curl.h>
 
 #include "kyhttp_types.h"
 #include "kyhttp_buffer.h"
+#include "kyhttp_header.h"
+#include "kyhttp_share.h"
+#include "kyhttp_sink.h"
+#include "kyhttp_stream.h"
+#include "kyhttp_mapped.h"
+#include "kyhttp_encode.h"
+#include "kyhttp_cache.h"
+#include "kyhttp_diskcache.h"
+#include "kyhttp_retry.h"
+#include "kyhttp_hedge.h"
+#include "kyhttp_breaker.h"
+#include "kyhttp_bandwidth.h"
 #include <kyhttp_logger.h>
 
 __BEGIN_NAMESPACE__
@@ -47,6 +63,7 @@ __BEGIN_NAMESPACE__
 		-> HttpRawContent			 : text, json, xml, javascript, html
 		-> HttpUrlEncodedContent	 : encode param to body request
 		-> HttpMultipartContent		 : post multipart data
+		-> MappedFileContent		 : post memory mapped file (no copy)
 	HttpRequest :
 	HttpResponse:
 	HttpClient  :
@@ -69,6 +86,7 @@ public:
 	};
 private:
 	HttpBuffer	  m_rawbuffer;
+	HttpStreamSourcePtr m_stream;	// not null : body is streamed (SetRawFile)
 
 	RAW_TYPE      m_rawtype;
 	std::string   m_str_rawtype; 
@@ -76,14 +94,24 @@ private:
 private:
 	virtual ContentType GetType() const
 	{
-		return ContentType::raw;
+		return m_stream ? ContentType::stream : ContentType::raw;
 	}
 
 	virtual void* InitContent(IN void* base)
 	{
+		if (m_stream)
+		{
+			return m_stream->Rewind() ? m_stream.get() : NULL;
+		}
 		return &m_rawbuffer;
 	}
 
+	virtual void ReleaseContent()
+	{
+		if (m_stream)
+			m_stream->Release();
+	}
+
 private:
 	static std::string ConvertTypeToString(RAW_TYPE type)
 	{
@@ -112,8 +140,29 @@ private:
 public:
 	void SetRawData(const void* data, const unsigned int& size)
 	{
+		m_stream = nullptr;
 		m_rawbuffer.set(data, size);
 	}
+
+	/******************************************************************************
+	*! @brief  : send file without loading it to memory (read while sending)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	path : file path, opened when request is sent
+	*! @parameter:	sequential_hint : sequential read hint to OS cache (posix_fadvise, "S" mode)
+	*! @return : void
+	******************************************************************************/
+	void SetRawFile(const wchar_t* path, BOOL sequential_hint = TRUE)
+	{
+		m_rawbuffer.release();
+		m_stream = std::make_shared<HttpFileStream>(path, sequential_hint);
+	}
+
+	// user stream source
+	void SetRawStream(HttpStreamSourcePtr stream)
+	{
+		m_rawbuffer.release();
+		m_stream = stream;
+	}
 	
 	void SetRawData(const wchar_t* path)
 	{
@@ -221,8 +270,18 @@ public:
 ===================================================================================*/
 class HttpMultipartContent : public HttpContent
 {
+	enum PART_KIND
+	{
+		part_value,		// key - value
+		part_copy,		// data copied by curl (curl_mime_data)
+		part_memory,	// caller memory, not copied (curl_mime_data_cb)
+		part_file,		// file path read by curl (curl_mime_filedata)
+		part_stream,	// user IHttpStreamSource (curl_mime_data_cb)
+	};
+
 	struct HttpContentPart
 	{
+		PART_KIND			 m_kind;
 		std::string			 m_name;
 		std::string			 m_value;
 		std::string			 m_filename;
@@ -243,17 +302,23 @@ class HttpMultipartContent : public HttpContent
 			const void*		 m_data;
 			size_t			 m_size;
 		};
+
+		std::shared_ptr<const void> m_owner;	// part_memory : keep memory alive (nullptr : caller owns)
+		std::string			 m_file_path;		// part_file
+		HttpStreamSourcePtr	 m_stream;			// part_stream
 	};
 
 private:
 	struct curl_mime*			 m_curl_mine;
 	std::vector<HttpContentPart> m_part_list;
+	std::vector<HttpStreamSourcePtr> m_part_streams; // read cursor of parts (alive with m_curl_mine)
 
 private:
 	void FreeCurlMine()
 	{
 		curl_mime_free(m_curl_mine);
 		m_curl_mine = NULL;
+		m_part_streams.clear();
 	}
 
 	void InitCurlMine(IN CURL* curl)
@@ -293,19 +358,45 @@ private:
 			curl_mime_type(pPart, str_ct_type.c_str());
 		}
 
-		if (part_data.m_data)
+		curl_mime_name(pPart, part_data.m_name.c_str());
+
+		CURLcode curlcode = CURLE_OK;
+		switch (part_data.m_kind)
 		{
-			curl_mime_name(pPart, part_data.m_name.c_str());
+		case part_copy:
 			curl_mime_filename(pPart, part_data.m_filename.c_str());
-			curl_mime_data(pPart, (const char*)part_data.m_data, part_data.m_size);
-		}
-		else
+			curlcode = curl_mime_data(pPart, (const char*)part_data.m_data, part_data.m_size);
+			break;
+		case part_file:
+			// filedata set filename = base name of path -> override after
+			curlcode = curl_mime_filedata(pPart, part_data.m_file_path.c_str());
+			if (!part_data.m_filename.empty())
+				curl_mime_filename(pPart, part_data.m_filename.c_str());
+			break;
+		case part_memory:
+		case part_stream:
 		{
-			curl_mime_name(pPart, part_data.m_name.c_str());
-			curl_mime_data(pPart, part_data.m_value.c_str(), CURL_ZERO_TERMINATED);
+			// memory : new cursor for each mime (requests can share the same memory)
+			HttpStreamSourcePtr stream = part_data.m_stream;
+			if (part_memory == part_data.m_kind)
+				stream = std::make_shared<HttpMemoryStream>(part_data.m_data, part_data.m_size, part_data.m_owner);
+
+			if (!stream || !stream->Rewind())
+				return FALSE;
+
+			m_part_streams.push_back(stream);
+
+			curl_mime_filename(pPart, part_data.m_filename.c_str());
+			curlcode = curl_mime_data_cb(pPart, stream->Size(), &HttpStreamReadFunc, &HttpStreamSeekFunc,
+										 NULL, stream.get());
+			break;
+		}
+		default:
+			curlcode = curl_mime_data(pPart, part_data.m_value.c_str(), CURL_ZERO_TERMINATED);
+			break;
 		}
 
-		return TRUE;
+		return (curlcode == CURLE_OK) ? TRUE : FALSE;
 	}
 
 public:
@@ -321,8 +412,9 @@ public:
 	{
 		HttpContentPart part;
 
+		part.m_kind = part_value;
 		part.m_content_type = content_type;
-		part.m_content_parameter = content_parameter;
+		part.m_content_parameter = content_parameter ? content_parameter : "";
 		part.m_name  = name;
 		part.m_value = value;
 		part.m_data  = NULL;
@@ -340,6 +432,7 @@ public:
 	{
 		HttpContentPart part;
 
+		part.m_kind = part_copy;
 		part.m_content_type = content_type;
 		part.m_content_parameter = content_parameter ? content_parameter : "";
 		part.m_name     = name;
@@ -352,6 +445,114 @@ public:
 		m_part_list.push_back(part);
 	}
 
+	/******************************************************************************
+	*! @brief  : add file part referencing caller memory (curl reads it while sending)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	data : must stay alive until the request completes (or owner set)
+	*! @parameter:	owner : keep data alive with the content (nullptr : caller owns)
+	*! @return : void
+	******************************************************************************/
+	void AddPartData(const char* name, const char* filename,
+					 const void* data, size_t data_size,
+					 HttpContentType			 content_type	   = Auto,
+					 const char*				 content_parameter = NULL,
+					 const char*				 header_custom	   = NULL,
+					 std::shared_ptr<const void> owner			   = nullptr)
+	{
+		HttpContentPart part;
+
+		part.m_kind = part_memory;
+		part.m_content_type = content_type;
+		part.m_content_parameter = content_parameter ? content_parameter : "";
+		part.m_name     = name;
+		part.m_filename = filename ? filename : "";
+		part.m_data     = data;
+		part.m_size     = data_size;
+		part.m_owner    = owner;
+
+		part.m_header_custom = header_custom ? header_custom : "";
+
+		m_part_list.push_back(part);
+	}
+
+	/******************************************************************************
+	*! @brief  : add file part by path (curl opens and reads the file while sending)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	filename : NULL : base name of path
+	*! @return : void
+	******************************************************************************/
+	void AddPartFilePath(const char* name, const wchar_t* path,
+						 const char*		 filename		   = NULL,
+						 HttpContentType	 content_type	   = Auto,
+						 const char*		 content_parameter = NULL,
+						 const char*		 header_custom	   = NULL)
+	{
+		HttpContentPart part;
+
+		part.m_kind = part_file;
+		part.m_content_type = content_type;
+		part.m_content_parameter = content_parameter ? content_parameter : "";
+		part.m_name      = name;
+		part.m_filename  = filename ? filename : "";
+		part.m_file_path = kyhttp::convert_wc_to_string(path);
+		part.m_data      = NULL;
+		part.m_size      = 0;
+
+		part.m_header_custom = header_custom ? header_custom : "";
+
+		m_part_list.push_back(part);
+	}
+
+	/******************************************************************************
+	*! @brief  : add part read from user stream (Size() = -1 : chunked)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : void
+	*! @note   : one stream for one in-flight request
+	******************************************************************************/
+	void AddPartStream(const char* name, const char* filename,
+					   HttpStreamSourcePtr	stream,
+					   HttpContentType		content_type	  = Auto,
+					   const char*			content_parameter = NULL,
+					   const char*			header_custom	  = NULL)
+	{
+		HttpContentPart part;
+
+		part.m_kind = part_stream;
+		part.m_content_type = content_type;
+		part.m_content_parameter = content_parameter ? content_parameter : "";
+		part.m_name     = name;
+		part.m_filename = filename ? filename : "";
+		part.m_data     = NULL;
+		part.m_size     = 0;
+		part.m_stream   = stream;
+
+		part.m_header_custom = header_custom ? header_custom : "";
+
+		m_part_list.push_back(part);
+	}
+
+	/******************************************************************************
+	*! @brief  : add file part from memory mapped file (not copied to memory of request)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	mapped : MappedFile::Open(path) -> same file shared by many requests
+	*! @return : void
+	******************************************************************************/
+	void AddPartMappedFile(const char* name, const char* filename,
+						   MappedFilePtr		mapped,
+						   HttpContentType		content_type	  = Auto,
+						   const char*			content_parameter = NULL,
+						   const char*			header_custom     = NULL)
+	{
+		if (!mapped)
+		{
+			KY_HTTP_LOG_ERROR("[MultipartContent] mapped file part is null !");
+			return;
+		}
+
+		this->AddPartData(name, filename, mapped->data(), mapped->size(),
+						  content_type, content_parameter, header_custom, mapped);
+	}
+
 protected:
 	virtual ContentType GetType() const
 	{
@@ -375,6 +576,60 @@ protected:
 
 		return m_curl_mine;
 	}
+
+	// stream parts : file released (mime seek callback rewinds for next send)
+	virtual void ReleaseContent()
+	{
+		for (auto& stream : m_part_streams)
+		{
+			stream->Release();
+		}
+	}
+};
+
+/*==================================================================================
+* Class MappedFileContent
+* Body is a memory mapped file : curl sends from the mapping (CURLOPT_POSTFIELDS no copy)
+* Content-Type is set by HttpRequest::SetContentType
+===================================================================================*/
+class MappedFileContent : public HttpContent
+{
+private:
+	MappedFilePtr	m_mapped;
+
+public:
+	MappedFileContent(IN MappedFilePtr mapped = nullptr) : m_mapped(mapped)
+	{
+
+	}
+
+	// map file, the mapping is shared with other contents of the same path
+	BOOL Open(IN const wchar_t* path)
+	{
+		m_mapped = MappedFile::Open(path);
+		return m_mapped ? TRUE : FALSE;
+	}
+
+	void SetMappedFile(IN MappedFilePtr mapped)
+	{
+		m_mapped = mapped;
+	}
+
+	MappedFilePtr GetMappedFile() const
+	{
+		return m_mapped;
+	}
+
+protected:
+	virtual ContentType GetType() const
+	{
+		return ContentType::mapped;
+	}
+
+	virtual void* InitContent(IN void* base)
+	{
+		return m_mapped.get();
+	}
 };
 
 class HttpRequest : public std::enable_shared_from_this<HttpRequest>
@@ -382,12 +637,35 @@ class HttpRequest : public std::enable_shared_from_this<HttpRequest>
 protected: // property header data
 	HttpHeaderData		m_header_data;
 	HttpContent*		m_content;
+	HttpResponseSinkPtr	m_sink;
+
+	HttpContentEncoding	m_content_encoding;		// compress body before send (SetContentEncoding)
+	int					m_encode_level;
+	size_t				m_encode_min_size;		// smaller body is sent not compressed
+	double				m_encode_max_ratio;		// compressed / original over this -> sent not compressed
 
 private: // curl header data 
 	struct curl_slist*  m_curl_slist;
 	std::string		    m_buffer;
 
+private: // compressed body of the last send
+	HttpContentEncoding					m_applied_encoding;
+	std::unique_ptr<HttpContentEncoder>	m_encoder;
+	HttpBuffer							m_encoded_content;	// raw / urlencoded
+	std::shared_ptr<HttpCompressStream>	m_encoded_stream;	// stream / mapped
+
 public:
+	HttpRequest() : m_content(NULL),
+		m_content_encoding(KY_HTTP_ENCODING_IDENTITY),
+		m_encode_level(-1),
+		m_encode_min_size(1024),
+		m_encode_max_ratio(0.9),
+		m_curl_slist(NULL),
+		m_applied_encoding(KY_HTTP_ENCODING_IDENTITY)
+	{
+		m_header_data.m_content_type = HttpContentType::Auto;
+	}
+
 	~HttpRequest()
 	{
 		this->CurlHeaderFree();
@@ -397,6 +675,7 @@ private:
 	void CurlHeaderFree()
 	{
 		curl_slist_free_all(m_curl_slist);
+		m_curl_slist = NULL;
 	}
 
 	// TODO:
@@ -406,7 +685,7 @@ private:
 	}
 
 private:
-	void* CreateHeaderData()
+	void* CreateHeaderData(IN BOOL connection_header = TRUE)
 	{
 		this->CurlHeaderFree();
 
@@ -433,27 +712,53 @@ private:
 		if (!m_header_data.m_accept.empty())
 			append_curl_header(&m_curl_slist, "Accept: %s", m_header_data.m_accept.c_str());
 
-		if (!m_header_data.m_accept_encoding.empty())
-		{
-			append_curl_header(&m_curl_slist, "Accept-encoding: %s", m_header_data.m_accept_encoding.c_str());
-		}
-		else
-		{
-			append_curl_header(&m_curl_slist, "Accept-encoding: %s", "gzip, deflate, br");
-		}
+		// Accept-Encoding : set by HttpClient (CURLOPT_ACCEPT_ENCODING -> decoded by libcurl)
+
+		if (m_applied_encoding != KY_HTTP_ENCODING_IDENTITY)
+			append_curl_header(&m_curl_slist, "Content-Encoding: %s", get_content_encoding_name(m_applied_encoding));
 
 		for (int i = 0; i < m_header_data.m_extension.size(); i++)
 		{
 			append_curl_header(&m_curl_slist, m_header_data.m_extension[i].c_str());
 		}
 		append_curl_header(&m_curl_slist, "User-Agent: kohyoung");
-		append_curl_header(&m_curl_slist, "Connection: %s", "Keep-Alive");
+
+		// connection-specific header is not allowed in HTTP/2
+		if (connection_header)
+			append_curl_header(&m_curl_slist, "Connection: %s", "Keep-Alive");
 
 		return m_curl_slist;
 	}
 
+	// transfer done : file of stream content is closed (opened again by next send)
+	void ReleaseContent()
+	{
+		if (m_content)
+			m_content->ReleaseContent();
+	}
+
+	// stream content : start again from beginning (retry, redirect)
+	BOOL RewindContent()
+	{
+		if (m_encoded_stream)
+			return m_encoded_stream->Rewind();
+
+		if (!m_content || m_content->GetType() != ContentType::stream)
+			return TRUE;
+
+		return m_content->InitContent(NULL) ? TRUE : FALSE;
+	}
+
+	ContentType GetContentType() const
+	{
+		return m_content ? m_content->GetType() : ContentType::none;
+	}
+
 	void* CreateContentData(IN void* base, IN ContentType& type)
 	{
+		m_applied_encoding = KY_HTTP_ENCODING_IDENTITY;
+		m_encoded_stream   = nullptr;
+
 		if (!m_content || !base)
 			return NULL;
 
@@ -461,10 +766,94 @@ private:
 		void* content = m_content->InitContent(curl);
 
 		type = m_content->GetType();
+
+		if (content && m_content_encoding != KY_HTTP_ENCODING_IDENTITY)
+			content = this->EncodeContentData(content, type);
 		
 		return content;
 	}
 
+	/******************************************************************************
+	*! @brief  : compress body of raw / urlencoded / stream / mapped content
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	content : data of InitContent
+	*! @parameter:	type : [in/out] stream / mapped -> stream (compressed while sending)
+	*! @return : data to send (not compressed if small, ratio is poor or failed)
+	******************************************************************************/
+	void* EncodeContentData(IN void* content, IN OUT ContentType& type)
+	{
+		if (!is_content_encoding_supported(m_content_encoding))
+		{
+			KY_HTTP_LOG_WARN("Content encoding %s is not built, body is sent not compressed.",
+							 get_content_encoding_name(m_content_encoding));
+			return content;
+		}
+
+		if (!m_encoder || m_encoder->GetEncoding() != m_content_encoding)
+			m_encoder.reset(new HttpContentEncoder(m_content_encoding, m_encode_level));
+
+		if (ContentType::raw == type || ContentType::urlencoded == type)
+		{
+			HttpBuffer* buff = static_cast<HttpBuffer*>(content);
+			if (buff->length() < m_encode_min_size)
+				return content;
+
+			if (!m_encoder->EncodeBuffer((const char*)buff->buffer(), buff->length(), m_encoded_content))
+			{
+				KY_HTTP_LOG_ERROR("Compress content failed, body is sent not compressed.");
+				return content;
+			}
+
+			double ratio = (double)m_encoded_content.length() / (double)buff->length();
+			if (ratio > m_encode_max_ratio)
+			{
+				KY_HTTP_LOG("Compressed ratio %.2f is poor, body is sent not compressed.", ratio);
+				return content;
+			}
+
+			m_applied_encoding = m_content_encoding;
+			return &m_encoded_content;
+		}
+
+		if (ContentType::stream == type || ContentType::mapped == type)
+		{
+			// content is alive while sending -> source does not own it
+			HttpStreamSourcePtr source;
+			if (ContentType::stream == type)
+			{
+				source = HttpStreamSourcePtr(HttpStreamSourcePtr(), static_cast<IHttpStreamSource*>(content));
+			}
+			else
+			{
+				MappedFile* mapped = static_cast<MappedFile*>(content);
+				source = std::make_shared<HttpMemoryStream>(mapped->data(), mapped->size());
+			}
+
+			if (source->Size() >= 0 && static_cast<size_t>(source->Size()) < m_encode_min_size)
+				return content;
+
+			auto stream = std::make_shared<HttpCompressStream>(source, m_content_encoding, m_encode_level);
+
+			double ratio = stream->ProbeRatio();
+			if (ratio > m_encode_max_ratio)
+			{
+				KY_HTTP_LOG("Compressed ratio %.2f is poor, body is sent not compressed.", ratio);
+				return source->Rewind() ? content : NULL;
+			}
+
+			if (!stream->Rewind())
+				return ContentType::stream == type ? NULL : content;
+
+			m_encoded_stream   = stream;
+			m_applied_encoding = m_content_encoding;
+
+			type = ContentType::stream;
+			return m_encoded_stream.get();
+		}
+
+		return content;
+	}
+
 	friend class HttpClient;
 
 public:
@@ -484,11 +873,89 @@ public:
 		m_header_data.m_accept = accept;
 	}
 
+	/******************************************************************************
+	*! @brief  : compress request body (Content-Encoding header is added)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	encoding : gzip (KYHTTP_USE_ZLIB) / zstd (KYHTTP_USE_ZSTD) / identity : off
+	*! @parameter:	min_size : smaller body is not compressed
+	*! @parameter:	max_ratio : compressed / original over this -> not compressed
+	*! @parameter:	level : -1 : default level of the encoding
+	*! @return : void
+	*! @note   : raw, urlencoded, stream (SetRawFile), mapped content.
+	*!			 stream is compressed while sending (chunked), ratio probed on first block
+	*! @note   : opt-in at build time : curl_httprequest.vcxproj defines neither macro and
+	*!			 links no zlib / zstd -> default build logs a warning and sends the body
+	*!			 not compressed. Check is_content_encoding_supported(encoding) first.
+	******************************************************************************/
+	void SetContentEncoding(IN HttpContentEncoding encoding, IN size_t min_size = 1024,
+							IN double max_ratio = 0.9, IN int level = -1)
+	{
+		m_content_encoding = encoding;
+		m_encode_min_size  = min_size;
+		m_encode_max_ratio = max_ratio;
+		m_encode_level	   = level;
+	}
+
+	// encoding of body sent by the last request
+	HttpContentEncoding GetAppliedContentEncoding() const
+	{
+		return m_applied_encoding;
+	}
+
+	// empty : encodings supported by libcurl (HttpClientOption::m_decode_content)
 	virtual void SetAcceptEncoding(IN const char* accept_encoding)
 	{
 		m_header_data.m_accept_encoding = accept_encoding;
 	}
 
+	const std::string& GetAcceptEncoding() const
+	{
+		return m_header_data.m_accept_encoding;
+	}
+
+	// custom header. Ex: "Cache-Control: no-cache"
+	void AddHeader(IN const char* header)
+	{
+		if (header)
+			m_header_data.m_extension.push_back(header);
+	}
+
+	/******************************************************************************
+	*! @brief  : value of header will be sent (case-insensitive name)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : value / empty : not set
+	******************************************************************************/
+	std::string GetHeaderValue(IN const std::string& name) const
+	{
+		auto equal_name = [&](const char* other, size_t nsize)
+		{
+			if (name.size() != nsize)
+				return false;
+
+			for (size_t i = 0; i < nsize; i++)
+			{
+				if (tolower((unsigned char)name[i]) != tolower((unsigned char)other[i]))
+					return false;
+			}
+			return true;
+		};
+
+		if (equal_name("Host", 4))				return m_header_data.m_host;
+		if (equal_name("Accept", 6))			return m_header_data.m_accept;
+		if (equal_name("Accept-Encoding", 15))	return m_header_data.m_accept_encoding;
+
+		for (auto& header : m_header_data.m_extension)
+		{
+			size_t colon = header.find(':');
+			if (colon == std::string::npos || !equal_name(header.c_str(), colon))
+				continue;
+
+			size_t begin = header.find_first_not_of(" \t", colon + 1);
+			return begin == std::string::npos ? std::string() : header.substr(begin);
+		}
+		return std::string();
+	}
+
 	virtual void SetHost(IN const char* host)
 	{
 		m_header_data.m_host = host;
@@ -498,6 +965,12 @@ public:
 	{
 		m_content = content;
 	}
+
+	// nullptr : body is kept in HttpResponse::Content()
+	virtual void SetResponseSink(IN HttpResponseSinkPtr sink)
+	{
+		m_sink = sink;
+	}
 };
 
 
@@ -507,79 +980,88 @@ private:
 	LONG			m_status;
 
 	HttpBuffer		m_header;
-	HttpBuffer		m_content;
+	HttpHeaderTable	m_header_table;	// fields of last hop (offsets in m_header)
+	mutable HttpBuffer	m_content;		// segmented mode : flattened on demand by Content()
+	mutable std::mutex	m_content_lock;	// Content() called by many readers of completed response
+	SegmentedHttpBuffer	m_segment_content;
 
 	time_t			m_server_time;  // get second epoch
 	std::string		m_redirect_url; // get
+	HttpErrorCode	m_error_code;	// result of the transfer
+	LONG			m_num_connects; // number of new connections of the transfer
+	ULONGLONG		m_received_size;	// body bytes on the wire of last hop (compressed if Content-Encoding)
+	ULONGLONG		m_decoded_size;		// body bytes after decoding delivered to content / sink
+	BOOL			m_from_cache;		// served by HttpCache (fresh or 304)
+	UINT			m_retry_count;		// attempts sent again by retry policy
+	ULONGLONG		m_retry_delay;		// total wait before retries (ms)
 protected:
 
 public:
 	HttpResponse() : m_status(HttpStatusCode::NODEFINE),
-		m_server_time(0)
+		m_header_table(&m_header),
+		m_server_time(0),
+		m_error_code(HttpErrorCode::KY_HTTP_FAILED),
+		m_num_connects(0),
+		m_received_size(0),
+		m_decoded_size(0),
+		m_from_cache(FALSE),
+		m_retry_count(0),
+		m_retry_delay(0)
 	{
 		m_header.reserve(1000);
-		m_content.reserve(1000);
 	}
 
 protected:
 	virtual void Clear()
 	{
 		m_status = HttpStatusCode::NODEFINE;
+		m_error_code = HttpErrorCode::KY_HTTP_FAILED;
+		m_num_connects = 0;
+		m_received_size = 0;
+		m_decoded_size = 0;
+		m_from_cache = FALSE;
+		m_retry_count = 0;
+		m_retry_delay = 0;
 		m_header.clear();
+		m_header_table.Reset();
 		m_content.clear();
+		m_segment_content.clear();
 		m_redirect_url.clear();
 	}
 
-	BOOL SetTimeServer(const char* str_time)
+	// replace status, header and body by cached response
+	void LoadCache(IN const HttpCacheEntry& entry)
 	{
-		if (strncmp((char*)(str_time), "Date:", 5) != 0)
-			return FALSE;
+		m_status = entry.m_status;
+		m_header.set(entry.m_header->buffer(), entry.m_header->length());
+		m_content.set(entry.m_content_data, entry.m_content_size);
+		m_segment_content.clear();
+		m_from_cache = TRUE;
 
-		auto convert_to_int_month = [](const char* month) // [0->11]
-		{
-			const char* mthstr[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun",
-				"Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
-			for (int i = 0; i < 12; i++)
-			{
-				if (strcmp(mthstr[i], month) == 0)
-					return i;
-			}
-			return -1;
-		};
+		// index stored header again (line by line as header callback)
+		m_header_table.Reset();
 
-		auto convert_to_int_day_of_week = [](const char* dayofweek) // [0->6]
+		const char* data = (const char*)m_header.buffer();
+		size_t offset = 0;
+		while (offset < m_header.length())
 		{
-			const char* daystr[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
-			for (int i = 0; i < 7; i++)
-			{
-				if (strstr(dayofweek, daystr[i]))
-					return i;
-			}
-			return -1;
-		};
-
-		struct tm tm {};
-		const unsigned int mxlength = 26;
-		char strdayofweek[mxlength]{0};
-		char strmonth[mxlength]{0};
+			const char* end = (const char*)memchr(data + offset, '\n', m_header.length() - offset);
+			size_t nsize = end ? (size_t)(end - (data + offset)) + 1 : m_header.length() - offset;
 
-		//Ex:Date: Fri, 25 Nov 2022 10:47:10 GMT
-		auto ret = sscanf_s((char*)str_time, "Date: %s %d %s %d %d:%d:%d",
-			strdayofweek, mxlength, &tm.tm_mday, strmonth, mxlength, &tm.tm_year,
-			&tm.tm_hour, &tm.tm_min,
-			&tm.tm_sec);
-
-		tm.tm_mon = convert_to_int_month(strmonth);
-		tm.tm_year = tm.tm_year - 1900; // year passed since 1900 
+			m_header_table.ParseLine(offset, nsize);
+			offset += nsize;
+		}
+	}
 
-		m_server_time = mktime(&tm);
-		
-		if (m_server_time <= 0)
+	// Date header of response (Ex: Date: Fri, 25 Nov 2022 10:47:10 GMT)
+	BOOL SetTimeServer()
+	{
+		HttpHeaderValue date = m_header_table.GetHeader("Date");
+		if (!date || !kyhttp::parse_http_date(date.m_data, date.m_size, m_server_time))
 		{
 			m_server_time = 0;
 			return FALSE;
 		}
-
 		return TRUE;
 	}
 
@@ -600,7 +1082,22 @@ public:
 			kyhttp::write_data_file_append(path_fileout, pre, strlen(pre));
 		}
 
-		kyhttp::write_data_file_append(path_fileout, m_content.buffer(), m_content.length());
+		if (m_segment_content.empty())
+		{
+			kyhttp::write_data_file_append(path_fileout, m_content.buffer(), m_content.length());
+			return;
+		}
+
+		// segmented : write each segment, no contiguous copy
+		FILE* file = _wfsopen(path_fileout, L"ab+", SH_DENYNO);
+		if (!file)
+			return;
+
+		for (auto segment : m_segment_content)
+		{
+			fwrite(segment.m_data, sizeof(char), segment.m_size, file);
+		}
+		fclose(file);
 	}
 
 	virtual HttpStatusCode GetStatusCode() const
@@ -613,33 +1110,136 @@ public:
 		return m_server_time;
 	}
 
-	std::string GetRedirectUrl()
+	/******************************************************************************
+	*! @brief  : HTTP-date header to second epoch (Date, Last-Modified, Expires, ...)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	name : header name
+	*! @return : TRUE : ok / FALSE : not found or invalid date
+	******************************************************************************/
+	BOOL GetHeaderTime(IN const char* name, OUT time_t& time) const
 	{
-		return m_redirect_url;
+		HttpHeaderValue value = m_header_table.GetHeader(name);
+		if (!value)
+			return FALSE;
+
+		return kyhttp::parse_http_date(value.m_data, value.m_size, time);
 	}
 
-	virtual const HttpBuffer* Header() const
+	// 0 : not found or invalid
+	time_t GetLastModified() const
 	{
-		return &m_header;
+		time_t time = 0;
+		return GetHeaderTime("Last-Modified", time) ? time : 0;
 	}
 
-	virtual const HttpBuffer* Content() const
+	// 0 : not found / invalid date (RFC 7234 : invalid Expires means already expired)
+	time_t GetExpires() const
 	{
-		return &m_content;
+		time_t time = 0;
+		return GetHeaderTime("Expires", time) ? time : 0;
 	}
 
-	friend class HttpClient;
-};
+	virtual HttpErrorCode GetErrorCode() const
+	{
+		return m_error_code;
+	}
 
-struct HttpCookie : public ArrayObject<HttpCookieData>
-{
-protected:
-	ObjectPtr CreateCookie(const char* str_cookie = NULL)
+	// 0 : reused connection (keep-alive or HTTP/2 multiplexed)
+	virtual LONG GetNumConnects() const
 	{
-		ObjectPtr cookie = std::make_shared<HttpCookieData>();
-		if (!str_cookie)
-		{
-			return cookie;
+		return m_num_connects;
+	}
+
+	// body size received (compressed) / after decoding. Ex: ratio = decoded / received
+	ULONGLONG GetReceivedSize() const
+	{
+		return m_received_size;
+	}
+
+	ULONGLONG GetDecodedSize() const
+	{
+		return m_decoded_size;
+	}
+
+	// TRUE : body served by HttpCache (no transfer, or 304 revalidated)
+	BOOL IsFromCache() const
+	{
+		return m_from_cache;
+	}
+
+	// retries of the request (HttpRetryPolicy) and total wait before them (ms)
+	UINT GetRetryCount() const
+	{
+		return m_retry_count;
+	}
+
+	ULONGLONG GetRetryDelay() const
+	{
+		return m_retry_delay;
+	}
+
+	std::string GetRedirectUrl()
+	{
+		return m_redirect_url;
+	}
+
+	virtual const HttpBuffer* Header() const
+	{
+		return &m_header;
+	}
+
+	/******************************************************************************
+	*! @brief  : value of response header (last hop when redirect is followed)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	name : case-insensitive. Ex: "Content-Type"
+	*! @return : HttpHeaderValue (points to Header()) / invalid : not found
+	******************************************************************************/
+	HttpHeaderValue GetHeader(IN const char* name) const
+	{
+		return m_header_table.GetHeader(name);
+	}
+
+	// all values of header (Set-Cookie, ...) in order of response
+	std::vector<HttpHeaderValue> GetHeaders(IN const char* name) const
+	{
+		return m_header_table.GetHeaders(name);
+	}
+
+	const HttpHeaderTable* HeaderTable() const
+	{
+		return &m_header_table;
+	}
+
+	// segmented mode : first call copies segments to contiguous memory (use SegmentedContent to avoid)
+	virtual const HttpBuffer* Content() const
+	{
+		std::lock_guard<std::mutex> lock(m_content_lock);
+		if (m_content.empty() && !m_segment_content.empty())
+		{
+			m_content = m_segment_content.Flatten();
+		}
+		return &m_content;
+	}
+
+	// body received with HttpClientOption::m_segmented_content
+	virtual const SegmentedHttpBuffer* SegmentedContent() const
+	{
+		return &m_segment_content;
+	}
+
+	friend class HttpClient;
+	friend class AsyncHttpClient;
+};
+
+struct HttpCookie : public ArrayObject<HttpCookieData>
+{
+protected:
+	ObjectPtr CreateCookie(const char* str_cookie = NULL)
+	{
+		ObjectPtr cookie = std::make_shared<HttpCookieData>();
+		if (!str_cookie)
+		{
+			return cookie;
 		}
 
 		std::stringstream ss(str_cookie);
@@ -740,6 +1340,24 @@ private:
 	HttpMethod			m_request_method;
 	HttpCookie			m_cookie_recv;
 	HttpCookie			m_cookie_send;
+	HttpSharePoolPtr	m_share_pool;
+	HttpCachePtr		m_cache;
+	HttpCacheEntryPtr	m_cache_entry;		// stale entry revalidated by current request
+	std::string			m_cache_key;		// not empty : response of current request is cached
+	curl_slist*			m_cache_slist;		// conditional header when request has no header
+	HttpResponseSinkPtr	m_sink;				// sink of current request
+	BOOL				m_sink_started;		// OnHeaders called for current response
+	HttpRetryPolicyPtr	m_retry_policy;
+	HttpRetryPolicyPtr	m_option_retry_policy;	// from m_option.m_retry_connet when no policy attached
+	HttpCircuitBreakerPtr	m_circuit_breaker;
+	BOOL				m_circuit_probe;	// current attempt is the half-open probe
+	HttpBandwidthGovernorPtr	m_bandwidth_governor;
+	std::unique_ptr<HttpBandwidthLimiter> m_bandwidth;	// share of current request
+
+	UINT				m_attempt_count;	// attempts of current request (retry, redirect)
+	UINT				m_retry_count;
+	ULONGLONG			m_retry_delay;		// ms
+	UINT				m_retry_last_delay;	// ms
 
 	HttpClientProgress	m_progress;
 
@@ -756,6 +1374,21 @@ private:
 public:
 	HttpClient(): m_curl(nullptr),
 		m_request(nullptr), m_response(nullptr),
+		m_share_pool(nullptr),
+		m_cache(nullptr),
+		m_cache_entry(nullptr),
+		m_cache_slist(NULL),
+		m_sink(nullptr),
+		m_sink_started(FALSE),
+		m_retry_policy(nullptr),
+		m_option_retry_policy(nullptr),
+		m_circuit_breaker(nullptr),
+		m_circuit_probe(FALSE),
+		m_bandwidth_governor(nullptr),
+		m_attempt_count(0),
+		m_retry_count(0),
+		m_retry_delay(0),
+		m_retry_last_delay(0),
 		m_use_openssl(false),
 		m_use_custom_ssl(false)
 	{
@@ -764,6 +1397,9 @@ public:
 	~HttpClient()
 	{
 		this->Curl_Destroy();
+
+		curl_slist_free_all(m_cache_slist);
+		m_cache_slist = NULL;
 	}
 
 private:
@@ -781,6 +1417,12 @@ private:
 			return 1;
 		}
 
+		// upload over share of bandwidth governor : wait / pause
+		if (progress && progress->m_bandwidth)
+		{
+			progress->m_bandwidth->OnProgress(NowUploaded);
+		}
+
 		if (TotalToUpload > 0 && progress)
 		{
 			progress->m_action = 1;
@@ -808,18 +1450,53 @@ private:
 
 		if (client && client->m_response)
 		{
-			client->m_response->m_header.append((char*)header, size * nmemb);
+			HttpResponse* response = client->m_response.get();
 
-			// check and get time response server
-			if (client->m_option.m_get_server_time && strncmp((char*)(header), "Date:", 5) == 0 &&
-				FALSE == client->m_response->SetTimeServer((char*)header))
+			size_t offset = response->m_header.length();
+			response->m_header.append((char*)header, size * nmemb);
+			response->m_header_table.ParseLine(offset, size * nmemb);
+
+			// end of headers (empty line)
+			if (size * nmemb <= 2 && (((char*)header)[0] == '\r' || ((char*)header)[0] == '\n'))
 			{
-				KY_HTTP_LOG("format time received is incorrect");
+				// check and get time response server
+				if (client->m_option.m_get_server_time && FALSE == response->SetTimeServer())
+				{
+					KY_HTTP_LOG("format time received is incorrect");
+				}
+
+				client->ReserveContent();
 			}
 		}
 		return size * nmemb;
 	}
 
+	/******************************************************************************
+	*! @brief  : reserve body one time by Content-Length (headers completed)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : void
+	*! @note   : unknown length (chunked) or over m_max_content_reserve -> growth by append
+	*!			 compressed body : Content-Length is compressed size -> reserve is lower bound
+	******************************************************************************/
+	void ReserveContent()
+	{
+		if (m_sink || m_option.m_segmented_content || m_option.m_max_content_reserve <= 0)
+			return;
+
+		curl_off_t content_length = -1;
+		if (curl_easy_getinfo(m_curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &content_length) != CURLE_OK ||
+			content_length <= 0)
+			return;
+
+		if (content_length > static_cast<curl_off_t>(m_option.m_max_content_reserve))
+		{
+			KY_HTTP_LOG_WARN("Content-Length %lld is over reserve limit, not reserved.", (long long)content_length);
+			return;
+		}
+
+		m_response->m_content.reserve(static_cast<size_t>(content_length));
+	}
+
 	static int HttpReceiveConentResponseFunc(void* contents, size_t size, size_t nmemb, void* user_data)
 	{
 		HttpClient* client = static_cast<HttpClient*>(user_data);
@@ -830,22 +1507,106 @@ private:
 			return 0;
 		}
 
+		// over share of bandwidth governor : same data given again after resume
+		if (client && client->m_bandwidth && !client->m_bandwidth->OnReceive())
+		{
+			return CURL_WRITEFUNC_PAUSE;
+		}
+
+		if (client && client->m_sink)
+		{
+			return client->WriteSink((char*)contents, size * nmemb) ? size * nmemb : 0;
+		}
+
 		if (client && client->m_response)
 		{
-			client->m_response->m_content.append((char*)contents, size * nmemb);
+			client->m_response->m_decoded_size += size * nmemb;
+
+			if (client->m_option.m_segmented_content)
+				client->m_response->m_segment_content.append((char*)contents, size * nmemb);
+			else
+				client->m_response->m_content.append((char*)contents, size * nmemb);
 		}
 		return size * nmemb;
 	}
 
+	/******************************************************************************
+	*! @brief  : pass received body to sink of request
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : TRUE : continue / FALSE : abort transfer
+	******************************************************************************/
+	BOOL WriteSink(IN const char* data, IN size_t length)
+	{
+		if (!m_sink_started)
+		{
+			LONG status = 0;
+			curl_easy_getinfo(m_curl, CURLINFO_RESPONSE_CODE, &status);
+
+			// body of redirect response is dropped (same as HttpResponse)
+			if (status == HttpStatusCode::MOVED_PERMANENTLY && m_option.m_auto_redirect)
+				return TRUE;
+
+			// body of retry status is dropped : request can be sent again
+			HttpRetryPolicyPtr policy = this->GetRetryPolicy();
+			if (policy && policy->IsRetryStatus(status))
+				return TRUE;
+
+			m_sink_started = TRUE;
+
+			if (!m_sink->OnHeaders(status, m_response ? m_response->Header() : NULL))
+			{
+				KY_HTTP_LOG_WARN("Response sink refused headers.");
+				return FALSE;
+			}
+		}
+
+		// only body given to the sink (dropped redirect / retry body not counted)
+		if (m_response)
+			m_response->m_decoded_size += length;
+
+		return m_sink->OnData(data, length);
+	}
+
+	/******************************************************************************
+	*! @brief  : notify sink transfer done (once per request)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : void
+	******************************************************************************/
+	void CompleteSink(IN HttpErrorCode retcode)
+	{
+		if (!m_sink)
+			return;
+
+		HttpResponseSinkPtr sink = m_sink;
+		m_sink = nullptr;
+
+		// response without body
+		if (!m_sink_started && m_response && m_response->m_status != HttpStatusCode::NODEFINE)
+		{
+			m_sink_started = TRUE;
+			sink->OnHeaders(m_response->m_status, m_response->Header());
+		}
+
+		sink->OnComplete(retcode);
+	}
+
 private:
 	/******************************************************************************
 	*! @brief  : initialize , destroy curl
 	*! @author : thuong.nv - [Date] : 03/10/2022
 	*! @parameter:	header : header info struct
 	*! @return : bool : TRUE / FALSE
+	*! @note   : m_reuse_connection = TRUE -> only reset options, the handle keeps
+	*!			 its connection cache, DNS cache and TLS session for the next request
 	******************************************************************************/
 	BOOL Curl_Initialize()
 	{
+		if (m_curl && m_option.m_reuse_connection)
+		{
+			curl_easy_reset(m_curl);
+			return TRUE;
+		}
+
 		if (m_curl) 
 			this->Curl_Destroy();
 
@@ -860,18 +1621,18 @@ private:
 		m_curl = NULL;
 	}
 
-	CURLcode Curl_Execute(CURL* curl, const char* url, bool out_log = true)
+	static double Curl_GetTimeSecond(CURL* curl) // get time request information
 	{
-		auto curl_get_time_second = [](CURL* _curl) // get time request information
+		curl_off_t lrequest_time = 0;
+		if (curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &lrequest_time) == CURLE_OK)
 		{
-			curl_off_t lrequest_time = 0;
-			if (curl_easy_getinfo(_curl, CURLINFO_TOTAL_TIME_T, &lrequest_time) == CURLE_OK)
-			{
-				return double(lrequest_time) / 1000000.0;
-			}
-			return 0.0;
-		};
+			return double(lrequest_time) / 1000000.0;
+		}
+		return 0.0;
+	}
 
+	void Curl_SetupUrl(CURL* curl, const char* url, bool out_log = true)
+	{
 		curl_easy_setopt(m_curl, CURLOPT_URL, url);
 
 		if (out_log)
@@ -882,25 +1643,178 @@ private:
 						m_option.m_connect_timout,
 						m_option.m_auto_redirect ? "true" : "false");
 		}
+	}
+
+	CURLcode Curl_Execute(CURL* curl, const char* url, bool out_log = true)
+	{
+		this->Curl_SetupUrl(curl, url, out_log);
+
+		// over bandwidth share : wait in callback (one transfer on this thread)
+		if (m_bandwidth)
+			m_bandwidth->SetWait(TRUE);
 
 		CURLcode curlret = curl_easy_perform(m_curl);
-		m_request_time += curl_get_time_second(m_curl);
+		m_request_time += Curl_GetTimeSecond(m_curl);
 
-		unsigned int iTry = 0; // try connection
-		while ((CURLcode::CURLE_OPERATION_TIMEDOUT == curlret ||
-				CURLcode::CURLE_COULDNT_CONNECT == curlret) &&
-				iTry < m_option.m_retry_connet)
+		UINT delay_ms = 0;
+		while (this->CheckRetry(curlret, delay_ms))
 		{
-			KY_HTTP_LOG_WARN("Connection time out! %s -> Trying: %u.", url, iTry + 1);
-			curlret = curl_easy_perform(m_curl);
-			m_request_time += curl_get_time_second(m_curl);
+			if (delay_ms > 0)
+				std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
 
-			iTry++;
+			this->InitClearResponse();
+			this->RewindRequestContent();
+			curlret = curl_easy_perform(m_curl);
+			m_request_time += Curl_GetTimeSecond(m_curl);
 		}
 
 		return curlret;
 	}
 
+	// attached policy or policy of m_option.m_retry_connet (connect failed / timeout, no delay)
+	HttpRetryPolicyPtr GetRetryPolicy()
+	{
+		if (m_retry_policy || m_option.m_retry_connet == 0)
+			return m_retry_policy;
+
+		if (!m_option_retry_policy)
+		{
+			m_option_retry_policy = std::make_shared<HttpConnectRetryPolicy>(m_option.m_retry_connet);
+		}
+		return m_option_retry_policy;
+	}
+
+	// Retry-After of response (delay-seconds / HTTP-date) in ms | -1 : no header
+	// longer than max_ms : max_ms + 1 (no overflow, policy refuses the retry)
+	LONGLONG GetRetryAfter(IN LONGLONG max_ms) const
+	{
+		HttpHeaderValue value = m_response ? m_response->GetHeader("Retry-After") : HttpHeaderValue();
+		if (!value || value.empty())
+			return -1;
+
+		LONGLONG max_seconds = max_ms / 1000;
+		LONGLONG seconds	 = 0;
+
+		if (isdigit((unsigned char)value.m_data[0]))
+		{
+			for (size_t i = 0; i < value.m_size && isdigit((unsigned char)value.m_data[i]); i++)
+			{
+				seconds = seconds * 10 + (value.m_data[i] - '0');
+				if (seconds > max_seconds)
+					return max_ms + 1;
+			}
+			return seconds * 1000;
+		}
+
+		time_t retry_time = 0;
+		if (!kyhttp::parse_http_date(value.m_data, value.m_size, retry_time))
+			return -1;
+
+		time_t now = time(NULL);
+		if (retry_time <= now)
+			return 0;
+
+		seconds = (LONGLONG)(retry_time - now);
+		return (seconds > max_seconds) ? max_ms + 1 : seconds * 1000;
+	}
+
+	/******************************************************************************
+	*! @brief  : ask retry policy after an attempt (network error / retry status)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	curlret : result of the attempt
+	*! @parameter:	delay_ms : [out] wait before sending again
+	*! @return : TRUE : send again / FALSE : done
+	******************************************************************************/
+	BOOL CheckRetry(IN CURLcode curlret, OUT UINT& delay_ms)
+	{
+		delay_ms = 0;
+
+		HttpRetryPolicyPtr policy = this->GetRetryPolicy();
+		if (!policy && !m_circuit_breaker)
+			return FALSE;
+
+		char* effective_url = NULL;
+		curl_easy_getinfo(m_curl, CURLINFO_EFFECTIVE_URL, &effective_url);
+
+		Uri uri;
+		uri.location = effective_url ? effective_url : "";
+
+		HttpRetryContext context;
+		context.m_method	  = m_request_method;
+		context.m_origin	  = uri.get_origin();
+		context.m_curl_code	  = curlret;
+		context.m_status	  = 0;
+		context.m_retry_after = -1;
+		context.m_retry		  = m_retry_count;
+		context.m_last_delay  = m_retry_last_delay;
+
+		if (curlret == CURLE_OK)
+		{
+			curl_easy_getinfo(m_curl, CURLINFO_RESPONSE_CODE, &context.m_status);
+			if (policy)
+				context.m_retry_after = this->GetRetryAfter((LONGLONG)policy->GetMaxRetryAfter());
+		}
+
+		// breaker counts every attempt
+		if (m_circuit_breaker)
+		{
+			m_circuit_breaker->Report(context.m_origin, ConvertCURLCodeToHTTPCode(curlret), context.m_status, m_circuit_probe);
+			m_circuit_probe = FALSE;
+		}
+
+		if (!policy)
+			return FALSE;
+
+		if (++m_attempt_count == 1)
+			policy->OnRequest(context.m_origin);
+
+		// body already given to sink : can not be sent again
+		if (m_sink_started || !policy->ShouldRetry(context, delay_ms))
+			return FALSE;
+
+		// retry is a new attempt : circuit opened by the failures -> stop here
+		if (m_circuit_breaker && !m_circuit_breaker->Acquire(context.m_origin, m_circuit_probe))
+		{
+			KY_HTTP_LOG_WARN("[Retry] %s : circuit of host is open, no retry.", uri.location.c_str());
+			return FALSE;
+		}
+
+		m_retry_count++;
+		m_retry_delay	   += delay_ms;
+		m_retry_last_delay	= delay_ms;
+
+		KY_HTTP_LOG_WARN("[Retry] %s -> curl %d, status %ld : trying %u after %u ms.",
+						 uri.location.c_str(), (int)curlret, context.m_status, m_retry_count, delay_ms);
+		return TRUE;
+	}
+
+	/******************************************************************************
+	*! @brief  : circuit breaker of origin before the first attempt (no connection)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	uri : uri of request
+	*! @return : KY_HTTP_OK : send / KY_HTTP_CIRCUIT_OPEN : rejected (set to response, sink)
+	******************************************************************************/
+	HttpErrorCode CheckCircuit(IN const Uri& uri)
+	{
+		m_circuit_probe = FALSE;
+
+		if (!m_circuit_breaker || m_circuit_breaker->Acquire(uri.get_origin(), m_circuit_probe))
+			return HttpErrorCode::KY_HTTP_OK;
+
+		m_cache_key.clear();
+		m_cache_entry = nullptr;
+
+		// content prepared but not sent : close file of stream content (FinishRequest is skipped)
+		if (m_request && m_request_method == HttpMethod::POST)
+			m_request->ReleaseContent();
+
+		if (m_response)
+			m_response->m_error_code = HttpErrorCode::KY_HTTP_CIRCUIT_OPEN;
+		this->CompleteSink(HttpErrorCode::KY_HTTP_CIRCUIT_OPEN);
+
+		return HttpErrorCode::KY_HTTP_CIRCUIT_OPEN;
+	}
+
 	CURLcode Curl_GetRequestInfo(CURL* curl)
 	{
 		curl_off_t lrequest_size = 0;
@@ -923,12 +1837,20 @@ private:
 			m_download_size += value_size;
 		}
 
+		// size before decoding (last hop : response is cleared on redirect / retry)
+		curl_off_t lreceived_size = 0;
+		if (curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &lreceived_size) == CURLE_OK && lreceived_size > 0)
+		{
+			m_response->m_received_size += static_cast<ULONGLONG>(lreceived_size);
+		}
+
 		// send_recv data speed
 		curl_easy_getinfo(m_curl, CURLINFO_SPEED_UPLOAD,   &m_upload_speed);
 		curl_easy_getinfo(m_curl, CURLINFO_SPEED_DOWNLOAD, &m_download_speed);
 
 		// get status code
 		curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &m_response->m_status);
+		curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &m_response->m_num_connects);
 
 		return CURLcode::CURLE_OK;
 	}
@@ -1033,6 +1955,9 @@ private:
 		case kyhttp::KY_HTTP_INIT_REQUEST_FAIL:
 			return "init request failed";
 			break;
+		case kyhttp::KY_HTTP_CIRCUIT_OPEN:
+			return "Circuit of host is open (request not sent)";
+			break;
 		default:
 			break;
 		}
@@ -1112,12 +2037,34 @@ private:
 		m_request_method = method;
 	}
 
+	// limiter of attached governor for new request (progress callback)
+	void InitBandwidth()
+	{
+		if (!m_bandwidth_governor)
+		{
+			m_bandwidth.reset();
+		}
+		else
+		{
+			if (!m_bandwidth || m_bandwidth->GetGovernor() != m_bandwidth_governor)
+				m_bandwidth.reset(new HttpBandwidthLimiter(m_bandwidth_governor));
+
+			m_bandwidth->Begin(m_curl, m_option.m_bandwidth_priority);
+		}
+		m_progress.m_bandwidth = m_bandwidth.get();
+	}
+
 	HttpErrorCode ResetRequestInformation()
 	{
 		m_download_size = 0.0;
 		m_upload_size   = 0.0;
 		m_request_time  = 0.0;
 
+		m_attempt_count	   = 0;
+		m_retry_count	   = 0;
+		m_retry_delay	   = 0;
+		m_retry_last_delay = 0;
+
 		m_progress.m_cur_download   = 0.0;
 		m_progress.m_total_download = 0.0;
 		m_progress.m_cur_upload     = 0.0;
@@ -1153,15 +2100,35 @@ private:
 		{
 			// limit download kb.s
 			curl_off_t max_speed = 1024L * m_option.m_max_download_speed; // bytes/s
-			PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_MAX_RECV_SPEED_LARGE, m_option.m_max_download_speed));
+			PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_MAX_RECV_SPEED_LARGE, max_speed));
+		}
+
+		// content decoding : request can override list (HttpRequest::SetAcceptEncoding)
+		if (option.m_decode_content)
+		{
+			PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_ACCEPT_ENCODING, GetSupportedContentEncoding()));
+		}
+		else
+		{
+			PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_HTTP_CONTENT_DECODING, 0L));
 		}
 
+		// HTTP/2 : wait for a connection can multiplex instead of opening a new one
+		if (option.m_http_version != HttpVersion::KY_HTTP_VERSION_DEFAULT)
+			PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_HTTP_VERSION, (long)option.m_http_version));
+		if (IsHttp2Version(option.m_http_version))
+			PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_PIPEWAIT, 1L));
+
 		// auto redirected
 		if (TRUE == option.m_auto_redirect)
 		{
 			PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_FOLLOWLOCATION, 0L));
 		}
 
+		// connection, dns, ssl session shared with other clients
+		// always set : curl_easy_reset keeps the share of reused handle (NULL = detach)
+		PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_SHARE, m_share_pool ? m_share_pool->Handle() : NULL));
+
 		/* enable the cookie engine */
 		PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_COOKIEFILE, ""));
 
@@ -1186,6 +2153,7 @@ private:
 		{
 			m_response->Clear();
 		}
+		m_sink_started = FALSE;
 
 		curl_easy_setopt(m_curl, CURLOPT_HEADERFUNCTION, &HttpClient::HttpReceiveHeaderResponseFunc);
 		curl_easy_setopt(m_curl, CURLOPT_HEADERDATA, this);
@@ -1276,6 +2244,8 @@ private:
 		PASS_ERROR_CODE(err_code, this->CreateProxyOption(&m_proxy));
 		PASS_ERROR_CODE(err_code, this->InitClearResponse());
 
+		this->InitBandwidth();
+
 		KY_HTTP_LOG("HttpRequest initialization done <0x%x>", err_code);
 		return err_code;
 	}
@@ -1292,6 +2262,9 @@ private:
 		// please set the method before setting the request data
 		this->SetRequestMethod(method);
 
+		// request of previous call : not used by this one (cache Vary key, content)
+		m_request = nullptr;
+
 		if (HttpMethod::GET == method && NULL == request)
 			return HttpErrorCode::KY_HTTP_OK;
 
@@ -1306,6 +2279,18 @@ private:
 		ContentType type = ContentType::none;
 		void* content_request = request->CreateContentData(m_curl, type);
 
+		if (ContentType::stream == type && content_request == NULL)
+		{
+			KY_HTTP_LOG_ERROR("Open stream content failed.");
+			return HttpErrorCode::KY_HTTP_CREATEDATA_REQUEST_FAIL;
+		}
+
+		if (ContentType::mapped == type && content_request == NULL)
+		{
+			KY_HTTP_LOG_ERROR("Mapped file content is not opened.");
+			return HttpErrorCode::KY_HTTP_CREATEDATA_REQUEST_FAIL;
+		}
+
 		// use when post not data content
 		if (HttpMethod::POST == method && (content_request == NULL || ContentType::none == type))
 		{
@@ -1322,7 +2307,7 @@ private:
 			if (buff)
 			{
 				PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_POSTFIELDS, buff->buffer()));
-				PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_POSTFIELDSIZE, buff->length()));
+				PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(buff->length())));
 			}
 		}
 		else if (ContentType::raw == type)
@@ -1331,18 +2316,53 @@ private:
 			if (buff)
 			{
 				PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_POSTFIELDS, buff->buffer()));
-				PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_POSTFIELDSIZE, buff->length()));
+				PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(buff->length())));
 			}
 		}
+		else if (ContentType::stream == type)
+		{
+			// unknown size : chunked transfer encoding
+			IHttpStreamSource* stream = static_cast<IHttpStreamSource*>(content_request);
+			PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_READFUNCTION, &HttpStreamReadFunc));
+			PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_READDATA, stream));
+			PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_SEEKFUNCTION, &HttpStreamSeekFunc));
+			PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_SEEKDATA, stream));
+			PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_POSTFIELDSIZE_LARGE, stream->Size()));
+		}
+		else if (ContentType::mapped == type)
+		{
+			// empty file : not mapped -> "" (NULL is read callback mode)
+			MappedFile* mapped = static_cast<MappedFile*>(content_request);
+			PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(mapped->size())));
+			PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_POSTFIELDS, mapped->data() ? mapped->data() : ""));
+		}
 
 		// create header request data
-		curl_slist* header = static_cast<curl_slist*>(request->CreateHeaderData());
-		if (header && ContentType::raw == type)
+		curl_slist* header = static_cast<curl_slist*>(request->CreateHeaderData(!IsHttp2Version(m_option.m_http_version)));
+		// content type of raw content : only HttpRawContent reports raw / stream (SetRawFile)
+		// (mapped content reports mapped, also when it is sent compressed as a stream)
+		ContentType content_type = request->GetContentType();
+		if (header && (ContentType::raw == content_type || ContentType::stream == content_type))
 		{
 			HttpRawContent* rawHttp = static_cast<HttpRawContent*>(request->m_content);
 			if (rawHttp)
 				curl_slist_append(header, rawHttp->GetRawTypeToString());
 		}
+		// decode on : libcurl sends header and decodes / off : raw header, body kept encoded
+		const std::string& accept_encoding = request->GetAcceptEncoding();
+		if (!accept_encoding.empty())
+		{
+			if (m_option.m_decode_content)
+			{
+				PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_ACCEPT_ENCODING, accept_encoding.c_str()));
+			}
+			else
+			{
+				std::string accept_header = "Accept-Encoding: " + accept_encoding;
+				header = curl_slist_append(header, accept_header.c_str());
+				request->m_curl_slist = header;
+			}
+		}
 		curl_easy_setopt(m_curl, CURLOPT_TCP_KEEPALIVE, 1L);
 
 		PASS_CURL_EXEC(curlcode, curl_easy_setopt(m_curl, CURLOPT_HTTPHEADER, header));
@@ -1353,7 +2373,71 @@ private:
 		return retcode;
 	}
 
+	/******************************************************************************
+	*! @brief  : init curl handle and setup request data (not send)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	method : GET / POST
+	*! @parameter:	HttpRequest : Contains header and content information
+	*! @return : HttpErrorCode
+	******************************************************************************/
+	HttpErrorCode PrepareRequest(IN HttpMethod method, IN HttpRequest* request)
+	{
+		HttpErrorCode retcode = HttpErrorCode::KY_HTTP_OK;
+
+		m_sink = request ? request->m_sink : nullptr;
+
+		if (!CHECK_HTTP_ERROR_OK(retcode, this->InitHttpRequest()))
+		{
+			KY_HTTP_LOG_ERROR("Init request failed. %s", GetStringErrorCode(retcode).c_str());
+			this->CompleteSink(HttpErrorCode::KY_HTTP_INIT_REQUEST_FAIL);
+			return HttpErrorCode::KY_HTTP_INIT_REQUEST_FAIL;
+		}
+
+		if (!CHECK_HTTP_ERROR_OK(retcode, this->CreateRequestData(method, request)))
+		{
+			KY_HTTP_LOG_ERROR("Created data request failed. %s", GetStringErrorCode(retcode).c_str());
+			this->CompleteSink(HttpErrorCode::KY_HTTP_CREATEDATA_REQUEST_FAIL);
+			return HttpErrorCode::KY_HTTP_CREATEDATA_REQUEST_FAIL;
+		}
+
+		return retcode;
+	}
+
+public:
+	/******************************************************************************
+	*! @brief  : content encodings decoded by the linked libcurl
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : Ex: "gzip, deflate, br, zstd" / "identity" : libcurl built without decoder
+	******************************************************************************/
+	static const char* GetSupportedContentEncoding()
+	{
+		static const std::string encodings = []()
+		{
+			std::string list;
+			const curl_version_info_data* info = curl_version_info(CURLVERSION_NOW);
+			if (info && (info->features & CURL_VERSION_LIBZ))
+				list.append("gzip, deflate");
+#ifdef CURL_VERSION_BROTLI
+			if (info && (info->features & CURL_VERSION_BROTLI))
+				list.append(list.empty() ? "br" : ", br");
+#endif // CURL_VERSION_BROTLI
+#ifdef CURL_VERSION_ZSTD
+			if (info && (info->features & CURL_VERSION_ZSTD))
+				list.append(list.empty() ? "zstd" : ", zstd");
+#endif // CURL_VERSION_ZSTD
+			return list.empty() ? std::string("identity") : list;
+		}();
+
+		return encodings.c_str();
+	}
+
 private:
+	static BOOL IsHttp2Version(IN HttpVersion version)
+	{
+		return (version == HttpVersion::KY_HTTP_VERSION_2 ||
+				version == HttpVersion::KY_HTTP_VERSION_2_PRIOR_KNOWLEDGE) ? TRUE : FALSE;
+	}
+
 	static std::string get_string_method(IN HttpMethod method)
 	{
 		switch (method)
@@ -1375,6 +2459,13 @@ private:
 		if (!m_curl)
 			return HttpErrorCode::KY_HTTP_FAILED;
 
+		if (!redirect)
+		{
+			HttpErrorCode retcode = this->CheckCircuit(uri);
+			if (retcode != HttpErrorCode::KY_HTTP_OK)
+				return retcode;
+		}
+
 		std::string url = uri.get_url();
 
 		if (redirect)
@@ -1383,34 +2474,294 @@ private:
 		CURLcode curlret = this->Curl_Execute(m_curl, url.c_str(), redirect? false:true);
 		PASS_CURL_EXEC(curlret, this->Curl_GetRequestInfo(m_curl));
 
-		if (m_response->m_status == HttpStatusCode::MOVED_PERMANENTLY)
+		Uri redirect_uri;
+		if (this->CheckRedirect(uri, redirect_uri))
 		{
-			this->InitClearResponse();
-			
-			char* redirect_url = NULL;
-			curl_easy_getinfo(m_curl, CURLINFO_REDIRECT_URL, &redirect_url);
+			this->RewindRequestContent();
+			return SendRequest(redirect_uri, TRUE);
+		}
 
-			if (redirect_url) 
-				m_response->m_redirect_url = redirect_url;
+		return this->FinishRequest(curlret);
+	}
 
-			if (m_option.m_auto_redirect)
-			{
-				Uri redirect_uri = uri;
-				redirect_uri.location = m_response->GetRedirectUrl();
-				return SendRequest(redirect_uri, TRUE);
-			}
+	// body of stream content is sent again from beginning
+	void RewindRequestContent()
+	{
+		if (m_request && m_request_method == HttpMethod::POST && !m_request->RewindContent())
+		{
+			KY_HTTP_LOG_ERROR("Rewind stream content failed.");
+		}
+	}
+
+	/******************************************************************************
+	*! @brief  : check response moved permanently and build redirect uri
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	uri : uri was requested
+	*! @parameter:	redirect_uri : [out] uri to follow
+	*! @return : TRUE : follow redirect_uri / FALSE : done
+	******************************************************************************/
+	BOOL CheckRedirect(IN const Uri& uri, OUT Uri& redirect_uri)
+	{
+		if (m_response->m_status != HttpStatusCode::MOVED_PERMANENTLY)
+			return FALSE;
+
+		this->InitClearResponse();
+
+		char* redirect_url = NULL;
+		curl_easy_getinfo(m_curl, CURLINFO_REDIRECT_URL, &redirect_url);
+
+		if (redirect_url) 
+			m_response->m_redirect_url = redirect_url;
+
+		if (m_option.m_auto_redirect)
+		{
+			redirect_uri = uri;
+			redirect_uri.location = m_response->GetRedirectUrl();
+			return TRUE;
 		}
+		return FALSE;
+	}
+
+	/******************************************************************************
+	*! @brief  : collect cookie, write log and set result code of the transfer
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	curlret : result of curl perform
+	*! @return : HttpErrorCode
+	******************************************************************************/
+	HttpErrorCode FinishRequest(IN CURLcode curlret)
+	{
 		this->Curl_GetCookie(m_curl);
 		this->Curl_WriteLogRequestInfo(curlret);
 
+		if (m_bandwidth)
+			m_bandwidth->End();
+
+		if (m_request && m_request_method == HttpMethod::POST)
+			m_request->ReleaseContent();
+
 		HttpErrorCode retcode = ConvertCURLCodeToHTTPCode(curlret);
+		m_response->m_error_code  = retcode;
+		m_response->m_retry_count = m_retry_count;
+		m_response->m_retry_delay = m_retry_delay;
+
+		if (!m_cache_key.empty())
+			this->UpdateCache(retcode);
+
+		this->CompleteSink(retcode);
 
 		return retcode;
 	}
+
+	/******************************************************************************
+	*! @brief  : GET through cache : fresh -> no transfer / stale -> conditional request
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	request : prepared request (nullptr : no header)
+	*! @return : HttpErrorCode
+	******************************************************************************/
+	HttpErrorCode SendCacheRequest(IN const Uri& uri, IN HttpRequest* request)
+	{
+		std::string cache_control = request ? request->GetHeaderValue("Cache-Control") : std::string();
+		if (cache_control.find("no-store") != std::string::npos)
+			return SendRequest(uri);
+
+		auto header_func = [request](const std::string& name)
+		{
+			return request ? request->GetHeaderValue(name) : std::string();
+		};
+
+		m_cache_key	  = "GET " + uri.get_url();
+		m_cache_entry = m_cache->Lookup(m_cache_key, header_func);
+
+		BOOL force_revalidate = cache_control.find("no-cache") != std::string::npos;
+		if (m_cache_entry && !force_revalidate && m_cache_entry->IsFresh(time(NULL)))
+		{
+			KY_HTTP_LOG("[Cache] Fresh : %s", m_cache_key.c_str());
+			m_cache->CountHit();
+
+			this->LoadCacheResponse(m_cache_entry);
+			m_cache_key.clear();
+			m_cache_entry = nullptr;
+
+			m_response->m_error_code = HttpErrorCode::KY_HTTP_OK;
+			this->CompleteSink(HttpErrorCode::KY_HTTP_OK);
+			return HttpErrorCode::KY_HTTP_OK;
+		}
+
+		if (m_cache_entry && m_cache_entry->HasValidator())
+		{
+			KY_HTTP_LOG("[Cache] Revalidate : %s", m_cache_key.c_str());
+			m_cache->CountRevalidate();
+			this->SetConditionalHeader(request, *m_cache_entry);
+		}
+		else
+		{
+			m_cache->CountMiss();
+			m_cache_entry = nullptr;
+		}
+
+		return SendRequest(uri);
+	}
+
+	// If-None-Match / If-Modified-Since of stale entry
+	void SetConditionalHeader(IN HttpRequest* request, IN const HttpCacheEntry& entry)
+	{
+		curl_slist_free_all(m_cache_slist);
+		m_cache_slist = NULL;
+
+		curl_slist* header = request ? request->m_curl_slist : NULL;
+
+		if (!entry.m_etag.empty())
+			header = curl_slist_append(header, ("If-None-Match: " + entry.m_etag).c_str());
+		if (!entry.m_last_modified.empty())
+			header = curl_slist_append(header, ("If-Modified-Since: " + entry.m_last_modified).c_str());
+
+		// list of request is freed by request, otherwise by client
+		if (request)
+			request->m_curl_slist = header;
+		else
+			m_cache_slist = header;
+
+		curl_easy_setopt(m_curl, CURLOPT_HTTPHEADER, header);
+	}
+
+	// 304 -> body of cache / 200 -> store
+	void UpdateCache(IN HttpErrorCode retcode)
+	{
+		std::string key = m_cache_key;
+		HttpCacheEntryPtr entry = m_cache_entry;
+
+		m_cache_key.clear();
+		m_cache_entry = nullptr;
+
+		if (retcode != HttpErrorCode::KY_HTTP_OK || !m_cache)
+			return;
+
+		if (m_response->m_status == HttpStatusCode::NOT_MODIFIED && entry)
+		{
+			KY_HTTP_LOG("[Cache] Not modified : %s", key.c_str());
+			this->LoadCacheResponse(m_cache->Refresh(entry, m_response->m_header_table));
+			return;
+		}
+
+		// body went to sink : nothing to store
+		if (m_sink)
+			return;
+
+		HttpRequestPtr request = m_request;
+		auto header_func = [request](const std::string& name)
+		{
+			return request ? request->GetHeaderValue(name) : std::string();
+		};
+
+		m_cache->Store(key, m_response->m_status, m_response->m_header, m_response->m_header_table,
+					   *m_response->Content(), header_func);
+	}
+
+	// response (and sink) receive cached body
+	void LoadCacheResponse(IN HttpCacheEntryPtr entry)
+	{
+		m_response->LoadCache(*entry);
+
+		if (m_sink && !m_sink_started)
+		{
+			m_sink_started = TRUE;
+			if (!m_sink->OnHeaders(m_response->m_status, m_response->Header()) ||
+				!m_sink->OnData(entry->m_content_data, entry->m_content_size))
+			{
+				m_response->m_error_code = HttpErrorCode::KY_HTTP_FAILED;
+			}
+		}
+	}
+
+	/******************************************************************************
+	*! @brief  : handle transfer done on a curl_multi (same flow with SendRequest)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	curlret : result of the transfer
+	*! @parameter:	uri		: [in/out] uri of the transfer, redirect uri if follow
+	*! @parameter:	delay_ms : [out] wait before adding handle again (retry)
+	*! @parameter:	retcode : [out] result when done
+	*! @return : TRUE : handle is ready to add to multi again (retry, redirect) / FALSE : done
+	******************************************************************************/
+	BOOL OnMultiTransferDone(IN CURLcode curlret, IN OUT Uri& uri, OUT UINT& delay_ms, OUT HttpErrorCode& retcode)
+	{
+		m_request_time += Curl_GetTimeSecond(m_curl);
+
+		// same rule with Curl_Execute, wait is done by caller (no sleep on multi)
+		if (this->CheckRetry(curlret, delay_ms))
+		{
+			this->InitClearResponse();
+			this->RewindRequestContent();
+			return TRUE;
+		}
+
+		PASS_CURL_EXEC(curlret, this->Curl_GetRequestInfo(m_curl));
+
+		Uri redirect_uri;
+		if (this->CheckRedirect(uri, redirect_uri))
+		{
+			uri = redirect_uri;
+
+			std::string url = redirect_uri.get_url();
+			KY_HTTP_LOG("[*] Redirect to : %s", url.c_str());
+			this->Curl_SetupUrl(m_curl, url.c_str(), false);
+			this->RewindRequestContent();
+			return TRUE;
+		}
+
+		retcode = this->FinishRequest(curlret);
+		return FALSE;
+	}
+
+	/******************************************************************************
+	*! @brief  : multi : continue transfer paused by bandwidth governor when its wait elapsed
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : wait (ms) before transfer can continue | -1 : not paused
+	******************************************************************************/
+	int ResumeBandwidth()
+	{
+		return m_bandwidth ? m_bandwidth->Resume() : -1;
+	}
+
+	// new client same setting (option, ssl, proxy, share pool, cache, retry policy, circuit breaker, bandwidth, cookie)
+	HttpClientPtr CloneClient() const
+	{
+		HttpClientPtr client = std::make_shared<HttpClient>();
+		client->m_option				= m_option;
+		client->m_ssl_setting			= m_ssl_setting;
+		client->m_proxy					= m_proxy;
+		client->m_share_pool			= m_share_pool;
+		client->m_cache					= m_cache;
+		client->m_retry_policy			= m_retry_policy;
+		client->m_circuit_breaker		= m_circuit_breaker;
+		client->m_bandwidth_governor	= m_bandwidth_governor;
+		client->m_cookie_send			= m_cookie_send;
+
+		return client;
+	}
+
+	// new client running the prepared transfer again with own response (hedged request)
+	HttpClientPtr DuplicateTransfer() const
+	{
+		CURL* curl = curl_easy_duphandle(m_curl);
+		if (!curl)
+			return nullptr;
+
+		HttpClientPtr client = this->CloneClient();
+		client->m_curl			 = curl;
+		client->m_request		 = m_request;	// owns header list used by the handle
+		client->m_request_method = m_request_method;
+		client->ResetRequestInformation();
+		client->InitClearResponse(TRUE);
+		client->InitBandwidth();
+
+		curl_easy_setopt(curl, CURLOPT_PROGRESSDATA, &client->m_progress);
+		return client;
+	}
 public:
 	virtual void Configunation(IN HttpClientOption& option)
 	{
 		m_option = option;
+		m_option_retry_policy = nullptr;
 	}
 
 	virtual void SettingProxy(IN WebProxy& proxy_info)
@@ -1428,6 +2779,41 @@ public:
 		m_cookie_send.Add(str_cookie);
 	}
 
+	// attach before request : HttpSharePool::Global() (DNS / TLS) or user-owned pool | nullptr = detach
+	// pool sharing connections : clients of one thread only
+	void AttachSharePool(IN HttpSharePoolPtr share_pool)
+	{
+		// kept handle (m_reuse_connection) must not refer to the old pool
+		if (m_curl && m_share_pool != share_pool)
+			curl_easy_setopt(m_curl, CURLOPT_SHARE, (CURLSH*)NULL);
+
+		m_share_pool = share_pool;
+	}
+
+	// GET responses cached (can be shared by many clients) | nullptr = detach
+	void AttachCache(IN HttpCachePtr cache)
+	{
+		m_cache = cache;
+	}
+
+	// retry rule (replace m_option.m_retry_connet), share between clients to share budget | nullptr = detach
+	void AttachRetryPolicy(IN HttpRetryPolicyPtr retry_policy)
+	{
+		m_retry_policy = retry_policy;
+	}
+
+	// fail fast when host is down : HttpCircuitBreaker::Global() (shared by process) | nullptr = detach
+	void AttachCircuitBreaker(IN HttpCircuitBreakerPtr circuit_breaker)
+	{
+		m_circuit_breaker = circuit_breaker;
+	}
+
+	// total bandwidth shared with other clients (priority : m_option.m_bandwidth_priority) | nullptr = detach
+	void AttachBandwidthGovernor(IN HttpBandwidthGovernorPtr bandwidth_governor)
+	{
+		m_bandwidth_governor = bandwidth_governor;
+	}
+
 	//There is no function will stop it immediately
 	void SetForceStop(IN BOOL stop)
 	{
@@ -1465,17 +2851,8 @@ public:
 
 		HttpErrorCode retcode = HttpErrorCode::KY_HTTP_OK;
 
-		if (!CHECK_HTTP_ERROR_OK(retcode, this->InitHttpRequest()))
-		{
-			KY_HTTP_LOG_ERROR("Init request failed. %s", GetStringErrorCode(retcode).c_str());
-			return HttpErrorCode::KY_HTTP_INIT_REQUEST_FAIL;
-		}
-
-		if (!CHECK_HTTP_ERROR_OK(retcode, this->CreateRequestData(HttpMethod::POST, request)))
-		{
-			KY_HTTP_LOG_ERROR("Created data request failed. %s", GetStringErrorCode(retcode).c_str());
-			return HttpErrorCode::KY_HTTP_CREATEDATA_REQUEST_FAIL;
-		}
+		if (!CHECK_HTTP_ERROR_OK(retcode, this->PrepareRequest(HttpMethod::POST, request)))
+			return retcode;
 
 		return SendRequest(uri);
 	}
@@ -1485,25 +2862,223 @@ public:
 		KY_HTTP_LOG("/////////////////////////////////////////////////////////////////////");
 		HttpErrorCode retcode = HttpErrorCode::KY_HTTP_OK;
 
-		if (!CHECK_HTTP_ERROR_OK(retcode, this->InitHttpRequest()))
+		if (!CHECK_HTTP_ERROR_OK(retcode, this->PrepareRequest(HttpMethod::GET, request)))
+			return retcode;
+
+		if (m_cache)
+			return SendCacheRequest(uri, request);
+
+		return SendRequest(uri);
+	}
+
+	/******************************************************************************
+	*! @brief  : send many requests concurrently (one curl_multi, caller thread)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	items  : requests, one HttpRequest object for one item
+	*! @parameter:	option : max in-flight, max per host
+	*! @return : results in submission order | Response() of this client not changed
+	******************************************************************************/
+	std::vector<HttpBatchResult> RequestBatch(IN const std::vector<HttpBatchItem>& items,
+											  IN const HttpBatchOption& option = HttpBatchOption())
+	{
+		struct BatchTransfer
 		{
-			KY_HTTP_LOG_ERROR("Init request failed. %s", GetStringErrorCode(retcode).c_str());
-			return HttpErrorCode::KY_HTTP_INIT_REQUEST_FAIL;
+			HttpClientPtr	m_client;
+			Uri				m_uri;
+			std::string		m_origin;
+		};
+
+		std::vector<HttpBatchResult> results(items.size(), { HttpErrorCode::KY_HTTP_FAILED, nullptr });
+		std::vector<BatchTransfer>	 transfers(items.size());
+
+		CURLM* multi = curl_multi_init();
+		if (!multi)
+		{
+			KY_HTTP_LOG_ERROR(L"[err] : init curl_multi failed !");
+			return results;
 		}
+		curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
 
-		if (!CHECK_HTTP_ERROR_OK(retcode, this->CreateRequestData(HttpMethod::GET, request)))
+		std::list<size_t>				 waiting;
+		std::map<CURL*, size_t>			 running;
+		std::map<std::string, UINT>		 host_running;
+
+		// retry waiting for its delay (keeps its slot : counted in host_running and in-flight)
+		typedef std::chrono::steady_clock Clock;
+		std::multimap<Clock::time_point, size_t> delayed;
+
+		for (size_t i = 0; i < items.size(); i++)
 		{
-			KY_HTTP_LOG_ERROR("Created data request failed. %s", GetStringErrorCode(retcode).c_str());
-			return HttpErrorCode::KY_HTTP_CREATEDATA_REQUEST_FAIL;
+			transfers[i].m_client = this->CloneClient();
+			transfers[i].m_uri	  = items[i].m_uri;
+			transfers[i].m_origin = items[i].m_uri.get_origin();
+			waiting.push_back(i);
 		}
 
-		return SendRequest(uri);
+		auto finish_item = [&](size_t i, HttpErrorCode retcode)
+		{
+			HttpResponsePtr response = transfers[i].m_client->Response();
+			if (!response)
+			{
+				response = std::make_shared<HttpResponse>();
+			}
+			response->m_error_code = retcode;
+			transfers[i].m_client->CompleteSink(retcode);
+
+			results[i].m_error_code = retcode;
+			results[i].m_response	= response;
+		};
+
+		auto add_item = [&](size_t i) -> BOOL
+		{
+			CURL* curl = transfers[i].m_client->m_curl;
+			if (curl_multi_add_handle(multi, curl) != CURLM_OK)
+			{
+				finish_item(i, HttpErrorCode::KY_HTTP_FAILED);
+				return FALSE;
+			}
+			running[curl] = i;
+			return TRUE;
+		};
+
+		while (!waiting.empty() || !running.empty() || !delayed.empty())
+		{
+			// retry delay elapsed
+			Clock::time_point now = Clock::now();
+			while (!delayed.empty() && delayed.begin()->first <= now)
+			{
+				size_t i = delayed.begin()->second;
+				delayed.erase(delayed.begin());
+
+				if (!add_item(i))
+					host_running[transfers[i].m_origin]--;
+			}
+
+			// start waiting items in submission order (skip host over limit)
+			for (auto it = waiting.begin(); it != waiting.end();)
+			{
+				if (option.m_max_in_flight > 0 && running.size() + delayed.size() >= option.m_max_in_flight)
+					break;
+
+				size_t i = *it;
+				UINT& nhost = host_running[transfers[i].m_origin];
+
+				if (option.m_max_per_host > 0 && nhost >= option.m_max_per_host)
+				{
+					++it;
+					continue;
+				}
+				it = waiting.erase(it);
+
+				if (HttpMethod::POST == items[i].m_method && nullptr == items[i].m_request)
+				{
+					KY_HTTP_LOG_ERROR("Post request nulls is not allowed !");
+					finish_item(i, HttpErrorCode::KY_HTTP_FAILED);
+					continue;
+				}
+
+				HttpClientPtr client = transfers[i].m_client;
+				HttpErrorCode retcode = client->PrepareRequest(items[i].m_method, items[i].m_request.get());
+
+				if (retcode == HttpErrorCode::KY_HTTP_OK)
+					retcode = client->CheckCircuit(transfers[i].m_uri);
+
+				if (retcode != HttpErrorCode::KY_HTTP_OK)
+				{
+					finish_item(i, retcode);
+					continue;
+				}
+
+				std::string url = transfers[i].m_uri.get_url();
+				client->Curl_SetupUrl(client->m_curl, url.c_str());
+
+				if (add_item(i))
+					nhost++;
+			}
+
+			if (running.empty())
+			{
+				if (!delayed.empty())
+					std::this_thread::sleep_until(delayed.begin()->first);
+				continue;
+			}
+
+			int running_handles = 0;
+			curl_multi_perform(multi, &running_handles);
+
+			int msgs_left = 0;
+			CURLMsg* msg = NULL;
+
+			while ((msg = curl_multi_info_read(multi, &msgs_left)) != NULL)
+			{
+				if (msg->msg != CURLMSG_DONE)
+					continue;
+
+				CURL* curl = msg->easy_handle;
+				CURLcode curlret = msg->data.result;
+
+				auto it = running.find(curl);
+				if (it == running.end())
+					continue;
+
+				size_t i = it->second;
+				running.erase(it);
+				curl_multi_remove_handle(multi, curl);
+
+				BatchTransfer& transfer = transfers[i];
+				HttpErrorCode retcode = HttpErrorCode::KY_HTTP_FAILED;
+				UINT delay_ms = 0;
+
+				if (transfer.m_client->OnMultiTransferDone(curlret, transfer.m_uri, delay_ms, retcode))
+				{
+					if (delay_ms > 0)
+					{
+						delayed.insert(std::make_pair(Clock::now() + std::chrono::milliseconds(delay_ms), i));
+						continue;
+					}
+
+					if (add_item(i))
+						continue;
+				}
+				else
+				{
+					finish_item(i, retcode);
+				}
+
+				host_running[transfer.m_origin]--;
+			}
+
+			if (!running.empty())
+			{
+				int timeout_ms = 1000;
+				if (!delayed.empty())
+				{
+					auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(delayed.begin()->first - Clock::now());
+					timeout_ms = (int)std::max<long long>(0, std::min<long long>(timeout_ms, wait.count()));
+				}
+
+				// paused by bandwidth governor
+				for (auto& it : running)
+				{
+					int wait_ms = transfers[it.second].m_client->ResumeBandwidth();
+					if (wait_ms >= 0)
+						timeout_ms = std::min(timeout_ms, wait_ms);
+				}
+				curl_multi_poll(multi, NULL, 0, timeout_ms, NULL);
+			}
+		}
+
+		curl_multi_cleanup(multi);
+
+		return results;
 	}
 
 	virtual HttpResponsePtr Response() const
 	{
 		return m_response;
 	}
+
+	friend class AsyncHttpClient;
 };
 
 __END___NAMESPACE__
\ No newline at end of file
@@ -0,0 +1,1037 @@
+/*!**********************************************************************
+* @copyright Copyright (C) 2022 thuong.nv -email: mark.ngo@kohyoung.com.\n
+*            All rights reserved.
+*************************************************************************
+* @file     kyhttp_diskcache.h
+* @date     Oct 17, 2026
+* @brief    HTTP client libcurl implementation file.
+*
+** Persistent HTTP cache store : memory mapped index + append-only segments
+** Shared by processes using the same directory (file lock on index)
+*************************************************************************/
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <ctime>
+#include <cerrno>
+#include <algorithm>
+#include <Windows.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif // _WIN32
+
+#include "kyhttp_types.h"
+#include "kyhttp_utils.h"
+#include "kyhttp_buffer.h"
+#include "kyhttp_cache.h"
+#include "kyhttp_logger.h"
+
+__BEGIN_NAMESPACE__
+
+class HttpDiskCache;
+typedef std::shared_ptr<HttpDiskCache> HttpDiskCachePtr;
+
+/*==================================================================================
+* Class HttpDiskFile
+* File opened by many processes : positional write, whole file lock, mapping
+===================================================================================*/
+class HttpDiskFile
+{
+private:
+#if defined(_WIN32)
+	HANDLE		m_file;
+#else
+	int			m_file;
+#endif // _WIN32
+
+public:
+#if defined(_WIN32)
+	HttpDiskFile() : m_file(INVALID_HANDLE_VALUE) {}
+#else
+	HttpDiskFile() : m_file(-1) {}
+#endif // _WIN32
+
+	~HttpDiskFile()
+	{
+		this->Close();
+	}
+
+	HttpDiskFile(const HttpDiskFile&) = delete;
+	HttpDiskFile& operator=(const HttpDiskFile&) = delete;
+
+public:
+	BOOL Open(IN const std::wstring& path)
+	{
+		this->Close();
+#if defined(_WIN32)
+		// share delete : segment removed by compaction of other process
+		m_file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+							 FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+							 OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+#else
+		std::string mbpath = kyhttp::convert_wc_to_string(path.c_str());
+		m_file = open(mbpath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+#endif // _WIN32
+		return this->IsOpen();
+	}
+
+	void Close()
+	{
+#if defined(_WIN32)
+		if (m_file != INVALID_HANDLE_VALUE)
+			CloseHandle(m_file);
+		m_file = INVALID_HANDLE_VALUE;
+#else
+		if (m_file >= 0)
+			close(m_file);
+		m_file = -1;
+#endif // _WIN32
+	}
+
+	BOOL IsOpen() const
+	{
+#if defined(_WIN32)
+		return m_file != INVALID_HANDLE_VALUE;
+#else
+		return m_file >= 0;
+#endif // _WIN32
+	}
+
+	ULONGLONG Size() const
+	{
+#if defined(_WIN32)
+		LARGE_INTEGER file_size;
+		return GetFileSizeEx(m_file, &file_size) ? (ULONGLONG)file_size.QuadPart : 0;
+#else
+		struct stat st;
+		return (fstat(m_file, &st) == 0) ? (ULONGLONG)st.st_size : 0;
+#endif // _WIN32
+	}
+
+	BOOL Resize(IN ULONGLONG nsize)
+	{
+#if defined(_WIN32)
+		LARGE_INTEGER position;
+		position.QuadPart = (LONGLONG)nsize;
+		return (SetFilePointerEx(m_file, position, NULL, FILE_BEGIN) && SetEndOfFile(m_file)) ? TRUE : FALSE;
+#else
+		return ftruncate(m_file, (off_t)nsize) == 0 ? TRUE : FALSE;
+#endif // _WIN32
+	}
+
+	BOOL WriteAt(IN ULONGLONG offset, IN const void* data, IN size_t nsize)
+	{
+		const char* pdata = static_cast<const char*>(data);
+		while (nsize > 0)
+		{
+			size_t nblock = (nsize > 0x40000000) ? 0x40000000 : nsize;
+#if defined(_WIN32)
+			OVERLAPPED overlapped = { 0 };
+			overlapped.Offset	  = (DWORD)(offset & 0xFFFFFFFF);
+			overlapped.OffsetHigh = (DWORD)(offset >> 32);
+
+			DWORD nwritten = 0;
+			if (!WriteFile(m_file, pdata, (DWORD)nblock, &nwritten, &overlapped) || nwritten == 0)
+				return FALSE;
+#else
+			ssize_t nwritten = pwrite(m_file, pdata, nblock, (off_t)offset);
+			if (nwritten <= 0)
+				return FALSE;
+#endif // _WIN32
+			pdata  += nwritten;
+			offset += nwritten;
+			nsize  -= nwritten;
+		}
+		return TRUE;
+	}
+
+	// lock between processes (threads of process : lock of HttpDiskCache)
+	BOOL Lock(IN BOOL exclusive)
+	{
+#if defined(_WIN32)
+		OVERLAPPED overlapped = { 0 };
+		return LockFileEx(m_file, exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0, 0, MAXDWORD, MAXDWORD, &overlapped);
+#else
+		return flock(m_file, exclusive ? LOCK_EX : LOCK_SH) == 0 ? TRUE : FALSE;
+#endif // _WIN32
+	}
+
+	void Unlock()
+	{
+#if defined(_WIN32)
+		OVERLAPPED overlapped = { 0 };
+		UnlockFileEx(m_file, 0, MAXDWORD, MAXDWORD, &overlapped);
+#else
+		flock(m_file, LOCK_UN);
+#endif // _WIN32
+	}
+
+	// map first nsize bytes (shared with other processes) / NULL : failed
+	void* Map(IN size_t nsize, IN BOOL writable) const
+	{
+		if (nsize == 0)
+			return NULL;
+#if defined(_WIN32)
+		HANDLE mapping = CreateFileMappingW(m_file, NULL, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, NULL);
+		if (!mapping)
+			return NULL;
+
+		// view keeps the mapping object
+		void* data = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, nsize);
+		CloseHandle(mapping);
+		return data;
+#else
+		void* data = mmap(NULL, nsize, PROT_READ | (writable ? PROT_WRITE : 0), MAP_SHARED, m_file, 0);
+		return (data == MAP_FAILED) ? NULL : data;
+#endif // _WIN32
+	}
+
+	static void Unmap(IN void* data, IN size_t nsize)
+	{
+		if (!data)
+			return;
+#if defined(_WIN32)
+		UnmapViewOfFile(data);
+#else
+		munmap(data, nsize);
+#endif // _WIN32
+	}
+
+	static BOOL Delete(IN const std::wstring& path)
+	{
+#if defined(_WIN32)
+		return DeleteFileW(path.c_str());
+#else
+		std::string mbpath = kyhttp::convert_wc_to_string(path.c_str());
+		return (unlink(mbpath.c_str()) == 0 || errno == ENOENT) ? TRUE : FALSE;
+#endif // _WIN32
+	}
+
+	static void CreateDir(IN const std::wstring& path)
+	{
+#if defined(_WIN32)
+		CreateDirectoryW(path.c_str(), NULL);
+#else
+		std::string mbpath = kyhttp::convert_wc_to_string(path.c_str());
+		mkdir(mbpath.c_str(), 0755);
+#endif // _WIN32
+	}
+};
+
+struct HttpDiskCacheStats
+{
+	size_t				m_entry_count;
+	size_t				m_slot_count;
+	ULONGLONG			m_live_bytes;		// records referenced by index
+	ULONGLONG			m_total_bytes;		// all segment bytes (live + replaced / removed)
+	UINT				m_active_segment;
+	unsigned long long	m_compact_count;	// by this process
+};
+
+/*==================================================================================
+* Class HttpDiskCache
+* Persistent store of HttpCache (AttachStore). Warm restart : stale entries are
+* revalidated (304) instead of downloaded again.
+*
+* index.kyc		 : header + open addressing table (key hash -> segment, offset, size,
+*				   freshness, last access), mapped read / write by all processes
+* segment_N.kys	 : append-only records (key, header, validators, vary, body)
+*
+* Body of loaded entry points to the mapping of segment (no copy).
+* Replaced / removed records are dead bytes : compaction copies live records (most
+* recently used first, until 3/4 of max size and 1/2 of index slots) to a new segment
+* and removes old ones.
+===================================================================================*/
+class HttpDiskCache : public IHttpCacheStore
+{
+private:
+	enum : UINT
+	{
+		INDEX_MAGIC	  = 0x4B594358,	// KYCX
+		INDEX_VERSION = 1,
+		RECORD_MAGIC  = 0x4B595243,	// KYRC
+	};
+
+	enum : UINT
+	{
+		SLOT_EMPTY	 = 0,
+		SLOT_USED	 = 1,
+		SLOT_DELETED = 2,
+	};
+
+	enum : UINT
+	{
+		SLOT_FLAG_NO_CACHE = 0x01,
+	};
+
+	// layout of files : fixed size types, no padding
+	struct IndexHeader
+	{
+		UINT		m_magic;
+		UINT		m_version;
+		UINT		m_slot_count;
+		UINT		m_entry_count;
+		UINT		m_deleted_count;
+		UINT		m_active_segment;	// segment of append
+		UINT		m_oldest_segment;	// first segment file not removed yet
+		UINT		m_reserved0;
+		ULONGLONG	m_live_bytes;
+		ULONGLONG	m_total_bytes;
+		ULONGLONG	m_reserved[4];
+	};
+
+	struct IndexSlot
+	{
+		ULONGLONG	m_hash;
+		UINT		m_state;
+		UINT		m_segment;
+		ULONGLONG	m_offset;
+		ULONGLONG	m_size;			// record size
+		LONGLONG	m_fresh_until;
+		LONGLONG	m_last_access;
+		UINT		m_flags;
+		UINT		m_reserved;
+	};
+
+	struct RecordHeader
+	{
+		UINT		m_magic;
+		UINT		m_status;
+		UINT		m_key_size;
+		UINT		m_header_size;
+		UINT		m_etag_size;
+		UINT		m_last_modified_size;
+		UINT		m_vary_size;		// "name\0value\0" ...
+		UINT		m_reserved;
+		ULONGLONG	m_content_size;		// content starts at 8 bytes alignment
+		LONGLONG	m_stored_time;
+	};
+
+	static_assert(sizeof(IndexHeader)  == 80, "disk cache index header layout");
+	static_assert(sizeof(IndexSlot)	   == 56, "disk cache index slot layout");
+	static_assert(sizeof(RecordHeader) == 48, "disk cache record layout");
+
+	// mapped view of segment : kept by loaded entries (body) until released
+	struct SegmentView
+	{
+		void*	m_data;
+		size_t	m_size;
+
+		SegmentView(void* data, size_t size) : m_data(data), m_size(size) {}
+		~SegmentView() { HttpDiskFile::Unmap(m_data, m_size); }
+	};
+	typedef std::shared_ptr<const SegmentView> SegmentViewPtr;
+
+	struct Segment
+	{
+		HttpDiskFile	m_file;
+		SegmentViewPtr	m_view;		// remapped when a record is after the end of view
+	};
+	typedef std::shared_ptr<Segment> SegmentPtr;
+
+	// lock of process + lock of file
+	class ScopedLock
+	{
+		std::lock_guard<std::mutex> m_guard;
+		HttpDiskFile&				m_file;
+	public:
+		ScopedLock(std::mutex& lock, HttpDiskFile& file, BOOL exclusive) : m_guard(lock), m_file(file)
+		{
+			m_file.Lock(exclusive);
+		}
+		~ScopedLock()
+		{
+			m_file.Unlock();
+		}
+	};
+
+private:
+	std::wstring			m_directory;
+	ULONGLONG				m_max_bytes;
+
+	std::mutex				m_lock;
+	HttpDiskFile			m_index_file;
+	IndexHeader*			m_header;		// mapped index
+	IndexSlot*				m_slots;
+	size_t					m_index_size;
+
+	std::map<UINT, SegmentPtr> m_segments;	// opened by this process
+	unsigned long long		m_compact_count;
+
+private:
+	HttpDiskCache(IN const wchar_t* directory, IN ULONGLONG max_bytes) :
+		m_directory(directory), m_max_bytes(max_bytes),
+		m_header(NULL), m_slots(NULL), m_index_size(0),
+		m_compact_count(0)
+	{
+
+	}
+
+	static ULONGLONG hash_key(IN const std::string& key)
+	{
+		ULONGLONG hash = 14695981039346656037ull;
+		for (size_t i = 0; i < key.size(); i++)
+		{
+			hash ^= (unsigned char)key[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	static ULONGLONG align8(IN ULONGLONG nsize)
+	{
+		return (nsize + 7) & ~(ULONGLONG)7;
+	}
+
+	static ULONGLONG content_offset(IN const RecordHeader& record)
+	{
+		return align8(sizeof(RecordHeader) + (ULONGLONG)record.m_key_size + record.m_header_size +
+					  record.m_etag_size + record.m_last_modified_size + record.m_vary_size);
+	}
+
+	static size_t index_size(IN UINT slot_count)
+	{
+		return sizeof(IndexHeader) + (size_t)slot_count * sizeof(IndexSlot);
+	}
+
+	std::wstring segment_path(IN UINT segment) const
+	{
+		return m_directory + L"/segment_" + std::to_wstring(segment) + L".kys";
+	}
+
+	/******************************************************************************
+	*! @brief  : map index file (create / reset when it is not valid)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : TRUE : ok / FALSE : failed
+	******************************************************************************/
+	BOOL OpenIndex(IN UINT slot_count)
+	{
+		HttpDiskFile::CreateDir(m_directory);
+
+		if (!m_index_file.Open(m_directory + L"/index.kyc"))
+		{
+			KY_HTTP_LOG_ERROR(L"[DiskCache] Open index failed: %ls", m_directory.c_str());
+			return FALSE;
+		}
+
+		m_index_file.Lock(TRUE);
+
+		// slot count of the existing index is kept
+		BOOL valid = FALSE;
+		ULONGLONG file_size = m_index_file.Size();
+		if (file_size >= sizeof(IndexHeader))
+		{
+			IndexHeader* header = static_cast<IndexHeader*>(m_index_file.Map(sizeof(IndexHeader), FALSE));
+			if (header)
+			{
+				valid = header->m_magic == INDEX_MAGIC && header->m_version == INDEX_VERSION &&
+						header->m_slot_count > 0 && file_size == index_size(header->m_slot_count);
+				if (valid)
+					slot_count = header->m_slot_count;
+
+				HttpDiskFile::Unmap(header, sizeof(IndexHeader));
+			}
+		}
+
+		// new index : zero filled -> all slots are empty
+		if (!valid && (!m_index_file.Resize(0) || !m_index_file.Resize(index_size(slot_count))))
+		{
+			m_index_file.Unlock();
+			return FALSE;
+		}
+
+		m_index_size = index_size(slot_count);
+		m_header	 = static_cast<IndexHeader*>(m_index_file.Map(m_index_size, TRUE));
+
+		if (m_header && !valid)
+		{
+			KY_HTTP_LOG(L"[DiskCache] New index : %ls", m_directory.c_str());
+			m_header->m_slot_count	   = slot_count;
+			m_header->m_active_segment = 1;
+			m_header->m_oldest_segment = 1;
+			m_header->m_version		   = INDEX_VERSION;
+			m_header->m_magic		   = INDEX_MAGIC;
+		}
+
+		m_index_file.Unlock();
+
+		if (!m_header)
+			return FALSE;
+
+		m_slots = reinterpret_cast<IndexSlot*>(m_header + 1);
+		return TRUE;
+	}
+
+	// lock held : segments removed by compaction (this or other process) are released
+	void SyncSegments()
+	{
+		while (!m_segments.empty() && m_segments.begin()->first < m_header->m_oldest_segment)
+		{
+			m_segments.erase(m_segments.begin());
+		}
+	}
+
+	// lock held
+	SegmentPtr GetSegment(IN UINT segment)
+	{
+		auto it = m_segments.find(segment);
+		if (it != m_segments.end())
+			return it->second;
+
+		SegmentPtr seg = std::make_shared<Segment>();
+		if (!seg->m_file.Open(segment_path(segment)))
+		{
+			KY_HTTP_LOG_ERROR(L"[DiskCache] Open segment failed: %ls", segment_path(segment).c_str());
+			return nullptr;
+		}
+
+		m_segments[segment] = seg;
+		return seg;
+	}
+
+	/******************************************************************************
+	*! @brief  : record of slot in mapping of segment (lock held)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	view : [out] mapping that contains the record
+	*! @return : record / NULL : missing or broken (crash while writing)
+	******************************************************************************/
+	const RecordHeader* GetRecord(IN const IndexSlot& slot, OUT SegmentViewPtr& view)
+	{
+		SegmentPtr seg = GetSegment(slot.m_segment);
+		if (!seg)
+			return NULL;
+
+		ULONGLONG end = slot.m_offset + slot.m_size;
+		if (!seg->m_view || seg->m_view->m_size < end)
+		{
+			// segment grew (append) : new view, old view stays with its entries
+			ULONGLONG file_size = seg->m_file.Size();
+			if (file_size < end)
+				return NULL;
+
+			void* data = seg->m_file.Map((size_t)file_size, FALSE);
+			if (!data)
+				return NULL;
+
+			seg->m_view = std::make_shared<SegmentView>(data, (size_t)file_size);
+		}
+
+		view = seg->m_view;
+		const RecordHeader* record = reinterpret_cast<const RecordHeader*>((const char*)view->m_data + slot.m_offset);
+
+		if (slot.m_size < sizeof(RecordHeader) || record->m_magic != RECORD_MAGIC ||
+			content_offset(*record) + record->m_content_size > slot.m_size)
+		{
+			KY_HTTP_LOG_WARN("[DiskCache] Broken record : segment %u offset %llu", slot.m_segment, slot.m_offset);
+			return NULL;
+		}
+		return record;
+	}
+
+	static std::string record_key(IN const RecordHeader* record)
+	{
+		return std::string((const char*)(record + 1), record->m_key_size);
+	}
+
+	// record of Vary names of key (no body) : not an entry key ("GET url")
+	static std::string vary_key(IN const std::string& key)
+	{
+		return "VARY " + key;
+	}
+
+	// "name\0value\0" ... of record
+	static std::vector<std::pair<std::string, std::string>> record_vary(IN const RecordHeader* record)
+	{
+		std::vector<std::pair<std::string, std::string>> vary;
+
+		const char* data = (const char*)(record + 1) + record->m_key_size + record->m_header_size +
+						   record->m_etag_size + record->m_last_modified_size;
+		const char* vary_end = data + record->m_vary_size;
+
+		while (data < vary_end)
+		{
+			const char* name_end = (const char*)memchr(data, '\0', vary_end - data);
+			const char* value_end = name_end ? (const char*)memchr(name_end + 1, '\0', vary_end - name_end - 1) : NULL;
+			if (!value_end)
+				break;
+
+			vary.push_back(std::make_pair(std::string(data, name_end), std::string(name_end + 1, value_end)));
+			data = value_end + 1;
+		}
+		return vary;
+	}
+
+	/******************************************************************************
+	*! @brief  : slot of key (lock held)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	insert : [out] slot to insert key (first deleted / empty slot)
+	*! @return : used slot of key / NULL : not found
+	******************************************************************************/
+	IndexSlot* FindSlot(IN const std::string& key, IN ULONGLONG hash, OUT IndexSlot** insert = NULL)
+	{
+		UINT slot_count = m_header->m_slot_count;
+		IndexSlot* free_slot = NULL;
+
+		for (UINT probe = 0; probe < slot_count; probe++)
+		{
+			IndexSlot& slot = m_slots[(hash + probe) % slot_count];
+
+			if (slot.m_state == SLOT_EMPTY)
+			{
+				if (!free_slot) free_slot = &slot;
+				break;
+			}
+
+			if (slot.m_state == SLOT_DELETED)
+			{
+				if (!free_slot) free_slot = &slot;
+				continue;
+			}
+
+			if (slot.m_hash != hash)
+				continue;
+
+			// same hash : compare key of record
+			SegmentViewPtr view;
+			const RecordHeader* record = GetRecord(slot, view);
+			if (record && record_key(record) == key)
+				return &slot;
+		}
+
+		if (insert)
+			*insert = free_slot;
+		return NULL;
+	}
+
+	// lock held
+	void RemoveSlot(IN IndexSlot* slot)
+	{
+		slot->m_state = SLOT_DELETED;
+		m_header->m_entry_count--;
+		m_header->m_deleted_count++;
+		m_header->m_live_bytes -= slot->m_size;
+	}
+
+	// lock held : record of entry appended to active segment
+	BOOL SaveLocked(IN const HttpCacheEntry& entry)
+	{
+		if (entry.m_etag.size() > 0xFFFF || entry.m_last_modified.size() > 0xFFFF)
+			return FALSE;
+
+		std::string vary;
+		for (auto& item : entry.m_vary)
+		{
+			vary.append(item.first).push_back('\0');
+			vary.append(item.second).push_back('\0');
+		}
+
+		RecordHeader record;
+		memset(&record, 0, sizeof(record));
+		record.m_magic				= RECORD_MAGIC;
+		record.m_status				= (UINT)entry.m_status;
+		record.m_key_size			= (UINT)entry.m_key.size();
+		record.m_header_size		= (UINT)(entry.m_header ? entry.m_header->length() : 0);
+		record.m_etag_size			= (UINT)entry.m_etag.size();
+		record.m_last_modified_size = (UINT)entry.m_last_modified.size();
+		record.m_vary_size			= (UINT)vary.size();
+		record.m_content_size		= entry.m_content_size;
+		record.m_stored_time		= (LONGLONG)entry.m_stored_time;
+
+		ULONGLONG offset_content = content_offset(record);
+		ULONGLONG record_size	 = align8(offset_content + record.m_content_size);
+
+		if (record_size > m_max_bytes / 8)
+			return FALSE;
+
+		// full : compaction removes deleted slots (and least recently used)
+		if ((ULONGLONG)(m_header->m_entry_count + m_header->m_deleted_count + 1) * 4 > (ULONGLONG)m_header->m_slot_count * 3)
+			this->CompactLocked();
+
+		ULONGLONG hash = hash_key(entry.m_key);
+		IndexSlot* free_slot = NULL;
+		IndexSlot* slot = FindSlot(entry.m_key, hash, &free_slot);
+
+		if (!slot && (!free_slot || (ULONGLONG)(m_header->m_entry_count + 1) * 4 > (ULONGLONG)m_header->m_slot_count * 3))
+		{
+			KY_HTTP_LOG_WARN("[DiskCache] Index is full : %s", entry.m_key.c_str());
+			return FALSE;
+		}
+
+		// record before index : index never points to a partial record
+		HttpBuffer head;
+		head.reserve((size_t)offset_content);
+		head.append((const char*)&record, sizeof(record));
+		head.append(entry.m_key.c_str(), entry.m_key.size());
+		if (entry.m_header)
+			head.append((const char*)entry.m_header->buffer(), entry.m_header->length());
+		head.append(entry.m_etag.c_str(), entry.m_etag.size());
+		head.append(entry.m_last_modified.c_str(), entry.m_last_modified.size());
+		head.append(vary.c_str(), vary.size());
+
+		const char padding[8] = { 0 };
+		head.append(padding, (size_t)(offset_content - head.length()));
+
+		UINT segment = m_header->m_active_segment;
+		SegmentPtr seg = GetSegment(segment);
+		if (!seg)
+			return FALSE;
+
+		ULONGLONG offset = align8(seg->m_file.Size());
+		if (!seg->m_file.WriteAt(offset, head.buffer(), head.length()) ||
+			!seg->m_file.WriteAt(offset + offset_content, entry.m_content_data, entry.m_content_size) ||
+			!seg->m_file.Resize(offset + record_size))
+		{
+			KY_HTTP_LOG_ERROR("[DiskCache] Write record failed : %s", entry.m_key.c_str());
+			return FALSE;
+		}
+
+		if (slot)
+			this->RemoveSlot(slot);
+		else
+			slot = free_slot;
+
+		if (slot->m_state == SLOT_DELETED)
+			m_header->m_deleted_count--;
+
+		slot->m_hash		= hash;
+		slot->m_segment		= segment;
+		slot->m_offset		= offset;
+		slot->m_size		= record_size;
+		slot->m_fresh_until = (LONGLONG)entry.m_fresh_until;
+		slot->m_last_access = (LONGLONG)time(NULL);
+		slot->m_flags		= entry.m_no_cache ? (UINT)SLOT_FLAG_NO_CACHE : 0u;
+		slot->m_state		= SLOT_USED;
+
+		m_header->m_entry_count++;
+		m_header->m_live_bytes	+= record_size;
+		m_header->m_total_bytes += record_size;
+
+		// over size or mostly dead records
+		ULONGLONG dead_bytes = m_header->m_total_bytes - m_header->m_live_bytes;
+		if (m_header->m_total_bytes > m_max_bytes ||
+			(dead_bytes > m_header->m_live_bytes && dead_bytes > m_max_bytes / 4))
+		{
+			this->CompactLocked();
+		}
+		return TRUE;
+	}
+
+	/******************************************************************************
+	*! @brief  : copy live records to new segment, remove old segments (lock held)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : void
+	*! @note   : least recently used records are dropped over 3/4 of max size or 1/2 of
+	*!			 slots -> index full (3/4 of slots) is not reached again by next save
+	******************************************************************************/
+	void CompactLocked()
+	{
+		std::vector<IndexSlot> live;
+		live.reserve(m_header->m_entry_count);
+
+		for (UINT i = 0; i < m_header->m_slot_count; i++)
+		{
+			if (m_slots[i].m_state == SLOT_USED)
+				live.push_back(m_slots[i]);
+		}
+
+		std::sort(live.begin(), live.end(), [](const IndexSlot& a, const IndexSlot& b)
+		{
+			return a.m_last_access > b.m_last_access;
+		});
+
+		UINT old_segment = m_header->m_active_segment;
+		UINT new_segment = old_segment + 1;
+
+		SegmentPtr seg = GetSegment(new_segment);
+		if (!seg || !seg->m_file.Resize(0))
+			return;
+
+		ULONGLONG budget	 = m_max_bytes / 4 * 3;
+		size_t	  max_entry	 = m_header->m_slot_count / 2;
+		ULONGLONG written	 = 0;
+		std::vector<IndexSlot> kept;
+
+		for (auto& slot : live)
+		{
+			if (kept.size() >= max_entry)
+				break;
+
+			if (written + slot.m_size > budget)
+				continue;
+
+			SegmentViewPtr view;
+			const RecordHeader* record = GetRecord(slot, view);
+			if (!record || !seg->m_file.WriteAt(written, record, (size_t)slot.m_size))
+				continue;
+
+			slot.m_segment = new_segment;
+			slot.m_offset  = written;
+			written += slot.m_size;
+			kept.push_back(slot);
+		}
+
+		memset(m_slots, 0, (size_t)m_header->m_slot_count * sizeof(IndexSlot));
+		for (auto& slot : kept)
+		{
+			UINT slot_count = m_header->m_slot_count;
+			for (UINT probe = 0; probe < slot_count; probe++)
+			{
+				IndexSlot& target = m_slots[(slot.m_hash + probe) % slot_count];
+				if (target.m_state == SLOT_EMPTY)
+				{
+					target = slot;
+					break;
+				}
+			}
+		}
+
+		KY_HTTP_LOG("[DiskCache] Compact : %zu / %zu entries, %llu -> %llu bytes",
+					kept.size(), live.size(), m_header->m_total_bytes, written);
+
+		m_header->m_entry_count	   = (UINT)kept.size();
+		m_header->m_deleted_count  = 0;
+		m_header->m_live_bytes	   = written;
+		m_header->m_total_bytes	   = written;
+		m_header->m_active_segment = new_segment;
+
+		// segment still mapped by other process (Windows) : removed by next compaction
+		UINT oldest = m_header->m_oldest_segment;
+		while (oldest < new_segment && HttpDiskFile::Delete(segment_path(oldest)))
+		{
+			oldest++;
+		}
+		m_header->m_oldest_segment = oldest;
+
+		// views kept by loaded entries are still valid
+		for (auto it = m_segments.begin(); it != m_segments.end();)
+		{
+			if (it->first < new_segment)
+				it = m_segments.erase(it);
+			else
+				++it;
+		}
+		m_compact_count++;
+	}
+
+public:
+	~HttpDiskCache()
+	{
+		m_segments.clear();
+		HttpDiskFile::Unmap(m_header, m_index_size);
+	}
+
+	HttpDiskCache(const HttpDiskCache&) = delete;
+	HttpDiskCache& operator=(const HttpDiskCache&) = delete;
+
+	/******************************************************************************
+	*! @brief  : open (or create) cache directory
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	directory : cache directory (same directory -> shared by processes)
+	*! @parameter:	max_bytes : size of segments before compaction
+	*! @parameter:	slot_count : entries of index when created (3/4 usable)
+	*! @return : HttpDiskCachePtr / nullptr : failed
+	******************************************************************************/
+	static HttpDiskCachePtr Open(IN const wchar_t* directory,
+								 IN ULONGLONG max_bytes = 256ull * 1024 * 1024,
+								 IN UINT slot_count = 16384)
+	{
+		HttpDiskCachePtr cache(new HttpDiskCache(directory, max_bytes));
+		if (!cache->OpenIndex(slot_count))
+			return nullptr;
+
+		return cache;
+	}
+
+	/******************************************************************************
+	*! @brief  : load entry (body in mapping of segment)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	key : method + url
+	*! @return : entry / nullptr : not found
+	******************************************************************************/
+	virtual HttpCacheEntryPtr Load(IN const std::string& key)
+	{
+		ScopedLock lock(m_lock, m_index_file, FALSE);
+		this->SyncSegments();
+
+		IndexSlot* slot = FindSlot(key, hash_key(key));
+		if (!slot)
+			return nullptr;
+
+		SegmentViewPtr view;
+		const RecordHeader* record = GetRecord(*slot, view);
+		if (!record)
+			return nullptr;
+
+		// shared lock : concurrent update of last access is harmless
+		slot->m_last_access = (LONGLONG)time(NULL);
+
+		const char* data = (const char*)(record + 1) + record->m_key_size;
+
+		auto entry = std::make_shared<HttpCacheEntry>();
+		entry->m_key		 = key;
+		entry->m_status		 = (LONG)record->m_status;
+		entry->m_stored_time = (time_t)record->m_stored_time;
+		entry->m_fresh_until = (time_t)slot->m_fresh_until;
+		entry->m_no_cache	 = (slot->m_flags & SLOT_FLAG_NO_CACHE) ? TRUE : FALSE;
+
+		auto header = std::make_shared<HttpBuffer>();
+		header->set(data, record->m_header_size);
+		entry->m_header = header;
+		data += record->m_header_size;
+
+		entry->m_etag.assign(data, record->m_etag_size);
+		data += record->m_etag_size;
+
+		entry->m_last_modified.assign(data, record->m_last_modified_size);
+		entry->m_vary = record_vary(record);
+
+		entry->m_content_owner = view;
+		entry->m_content_data  = (const char*)record + content_offset(*record);
+		entry->m_content_size  = (size_t)record->m_content_size;
+
+		return entry;
+	}
+
+	virtual BOOL Save(IN const HttpCacheEntry& entry)
+	{
+		ScopedLock lock(m_lock, m_index_file, TRUE);
+		this->SyncSegments();
+
+		return this->SaveLocked(entry);
+	}
+
+	/******************************************************************************
+	*! @brief  : entry refreshed by 304
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : TRUE : ok / FALSE : failed
+	*! @note   : same validators -> only index updated / changed -> record appended
+	******************************************************************************/
+	virtual BOOL Update(IN const HttpCacheEntry& entry)
+	{
+		ScopedLock lock(m_lock, m_index_file, TRUE);
+		this->SyncSegments();
+
+		IndexSlot* slot = FindSlot(entry.m_key, hash_key(entry.m_key));
+		if (slot)
+		{
+			SegmentViewPtr view;
+			const RecordHeader* record = GetRecord(*slot, view);
+			if (record)
+			{
+				const char* etag = (const char*)(record + 1) + record->m_key_size + record->m_header_size;
+				const char* last_modified = etag + record->m_etag_size;
+
+				if (entry.m_etag.compare(0, std::string::npos, etag, record->m_etag_size) == 0 &&
+					entry.m_last_modified.compare(0, std::string::npos, last_modified, record->m_last_modified_size) == 0)
+				{
+					slot->m_fresh_until = (LONGLONG)entry.m_fresh_until;
+					slot->m_last_access = (LONGLONG)time(NULL);
+					slot->m_flags		= entry.m_no_cache ? (UINT)SLOT_FLAG_NO_CACHE : 0u;
+					return TRUE;
+				}
+			}
+		}
+
+		return this->SaveLocked(entry);
+	}
+
+	virtual void Remove(IN const std::string& key)
+	{
+		ScopedLock lock(m_lock, m_index_file, TRUE);
+		this->SyncSegments();
+
+		IndexSlot* slot = FindSlot(key, hash_key(key));
+		if (slot)
+			this->RemoveSlot(slot);
+	}
+
+	/******************************************************************************
+	*! @brief  : save Vary names of key (record without body, evicted as an entry)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	key : method + url (without values of Vary request headers)
+	*! @parameter:	names : Vary request header names / empty : remove
+	*! @return : TRUE : ok / FALSE : failed
+	******************************************************************************/
+	virtual BOOL SaveVary(IN const std::string& key, IN const std::vector<std::string>& names)
+	{
+		ScopedLock lock(m_lock, m_index_file, TRUE);
+		this->SyncSegments();
+
+		std::string stub_key = vary_key(key);
+		if (names.empty())
+		{
+			IndexSlot* slot = FindSlot(stub_key, hash_key(stub_key));
+			if (slot)
+				this->RemoveSlot(slot);
+			return TRUE;
+		}
+
+		HttpCacheEntry stub;
+		stub.m_key = stub_key;
+		for (auto& name : names)
+		{
+			stub.m_vary.push_back(std::make_pair(name, std::string()));
+		}
+		return this->SaveLocked(stub);
+	}
+
+	virtual std::vector<std::string> LoadVary(IN const std::string& key)
+	{
+		ScopedLock lock(m_lock, m_index_file, FALSE);
+		this->SyncSegments();
+
+		std::vector<std::string> names;
+		std::string stub_key = vary_key(key);
+
+		IndexSlot* slot = FindSlot(stub_key, hash_key(stub_key));
+		if (!slot)
+			return names;
+
+		SegmentViewPtr view;
+		const RecordHeader* record = GetRecord(*slot, view);
+		if (!record)
+			return names;
+
+		// used with its variants : kept by compaction as long as them
+		slot->m_last_access = (LONGLONG)time(NULL);
+
+		for (auto& vary : record_vary(record))
+		{
+			names.push_back(vary.first);
+		}
+		return names;
+	}
+
+	// remove dead records now (also done when saving)
+	void Compact()
+	{
+		ScopedLock lock(m_lock, m_index_file, TRUE);
+		this->SyncSegments();
+		this->CompactLocked();
+	}
+
+	HttpDiskCacheStats GetStats()
+	{
+		ScopedLock lock(m_lock, m_index_file, FALSE);
+
+		HttpDiskCacheStats stats;
+		stats.m_entry_count	   = m_header->m_entry_count;
+		stats.m_slot_count	   = m_header->m_slot_count;
+		stats.m_live_bytes	   = m_header->m_live_bytes;
+		stats.m_total_bytes	   = m_header->m_total_bytes;
+		stats.m_active_segment = m_header->m_active_segment;
+		stats.m_compact_count  = m_compact_count;
+		return stats;
+	}
+};
+
+__END___NAMESPACE__
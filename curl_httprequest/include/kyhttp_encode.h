@@ -0,0 +1,375 @@
+/*!**********************************************************************
+* @copyright Copyright (C) 2022 thuong.nv -email: mark.ngo@kohyoung.com.\n
+*            All rights reserved.
+*************************************************************************
+* @file     kyhttp_encode.h
+* @date     Oct 17, 2026
+* @brief    HTTP client libcurl implementation file.
+*
+** Request body compression (Content-Encoding: gzip / zstd)
+** Off by default : zlib / zstd are not shipped with the project. Define KYHTTP_USE_ZLIB
+** and/or KYHTTP_USE_ZSTD (and add the library path) to build the encoders, else
+** SetContentEncoding logs a warning and the body is sent not compressed.
+*************************************************************************/
+#pragma once
+
+#include <memory>
+#include <string>
+#include <Windows.h>
+#include <curl/curl.h>
+
+#ifdef KYHTTP_USE_ZLIB
+#include <zlib.h>
+#pragma comment (lib, "zlib.lib")
+#endif // KYHTTP_USE_ZLIB
+
+#ifdef KYHTTP_USE_ZSTD
+#include <zstd.h>
+#pragma comment (lib, "zstd.lib")
+#endif // KYHTTP_USE_ZSTD
+
+#include "kyhttp_types.h"
+#include "kyhttp_buffer.h"
+#include "kyhttp_stream.h"
+#include "kyhttp_logger.h"
+
+__BEGIN_NAMESPACE__
+
+// encoding compiled in this build
+static BOOL is_content_encoding_supported(IN HttpContentEncoding encoding)
+{
+	switch (encoding)
+	{
+#ifdef KYHTTP_USE_ZLIB
+	case KY_HTTP_ENCODING_GZIP: return TRUE;
+#endif // KYHTTP_USE_ZLIB
+#ifdef KYHTTP_USE_ZSTD
+	case KY_HTTP_ENCODING_ZSTD: return TRUE;
+#endif // KYHTTP_USE_ZSTD
+	default: return FALSE;
+	}
+}
+
+// value of Content-Encoding header
+static const char* get_content_encoding_name(IN HttpContentEncoding encoding)
+{
+	switch (encoding)
+	{
+	case KY_HTTP_ENCODING_GZIP: return "gzip";
+	case KY_HTTP_ENCODING_ZSTD: return "zstd";
+	default: return "identity";
+	}
+}
+
+/*==================================================================================
+* Class HttpContentEncoder
+* Streaming compressor : Begin -> Update ... -> Finish, output appended to HttpBuffer
+===================================================================================*/
+class HttpContentEncoder
+{
+private:
+	HttpContentEncoding	m_encoding;
+	int					m_level;		// -1 : default level of the encoding
+	BOOL				m_started;
+
+#ifdef KYHTTP_USE_ZLIB
+	z_stream			m_zstream;
+#endif // KYHTTP_USE_ZLIB
+
+#ifdef KYHTTP_USE_ZSTD
+	ZSTD_CCtx*			m_zstd;
+#endif // KYHTTP_USE_ZSTD
+
+public:
+	HttpContentEncoder(IN HttpContentEncoding encoding, IN int level = -1) :
+		m_encoding(encoding), m_level(level), m_started(FALSE)
+	{
+#ifdef KYHTTP_USE_ZLIB
+		memset(&m_zstream, 0, sizeof(m_zstream));
+#endif // KYHTTP_USE_ZLIB
+#ifdef KYHTTP_USE_ZSTD
+		m_zstd = NULL;
+#endif // KYHTTP_USE_ZSTD
+	}
+
+	~HttpContentEncoder()
+	{
+		this->End();
+	}
+
+	HttpContentEncoder(const HttpContentEncoder&) = delete;
+	HttpContentEncoder& operator=(const HttpContentEncoder&) = delete;
+
+private:
+	void End()
+	{
+#ifdef KYHTTP_USE_ZLIB
+		if (m_started && m_encoding == KY_HTTP_ENCODING_GZIP)
+			deflateEnd(&m_zstream);
+#endif // KYHTTP_USE_ZLIB
+#ifdef KYHTTP_USE_ZSTD
+		if (m_zstd)
+		{
+			ZSTD_freeCCtx(m_zstd);
+			m_zstd = NULL;
+		}
+#endif // KYHTTP_USE_ZSTD
+		m_started = FALSE;
+	}
+
+	// compress input (finish : flush end of stream) -> append to output
+	BOOL Encode(IN const char* data, IN size_t nsize, IN BOOL finish, OUT HttpBuffer& output)
+	{
+		const size_t out_block = 64 * 1024;
+
+#ifdef KYHTTP_USE_ZLIB
+		if (m_encoding == KY_HTTP_ENCODING_GZIP)
+		{
+			// avail_in is uInt : feed by block
+			do
+			{
+				uInt nfeed = (uInt)(nsize > 0x40000000 ? 0x40000000 : nsize);
+				m_zstream.next_in  = (Bytef*)data;
+				m_zstream.avail_in = nfeed;
+				data  += nfeed;
+				nsize -= nfeed;
+
+				int flush = (finish && nsize == 0) ? Z_FINISH : Z_NO_FLUSH;
+				int ret = Z_OK;
+				do
+				{
+					size_t old_size = output.length();
+					if (!output.resize(old_size + out_block))
+						return FALSE;
+
+					m_zstream.next_out  = (Bytef*)output.buffer() + old_size;
+					m_zstream.avail_out = (uInt)out_block;
+
+					ret = deflate(&m_zstream, flush);
+					output.resize(old_size + out_block - m_zstream.avail_out);
+
+					if (ret == Z_STREAM_ERROR)
+						return FALSE;
+				}
+				while (m_zstream.avail_out == 0 || (flush == Z_FINISH && ret != Z_STREAM_END));
+			}
+			while (nsize > 0);
+
+			return TRUE;
+		}
+#endif // KYHTTP_USE_ZLIB
+
+#ifdef KYHTTP_USE_ZSTD
+		if (m_encoding == KY_HTTP_ENCODING_ZSTD)
+		{
+			ZSTD_inBuffer input = { data, nsize, 0 };
+			ZSTD_EndDirective mode = finish ? ZSTD_e_end : ZSTD_e_continue;
+
+			size_t remaining = 0;
+			do
+			{
+				size_t old_size = output.length();
+				if (!output.resize(old_size + out_block))
+					return FALSE;
+
+				ZSTD_outBuffer out = { (char*)output.buffer() + old_size, out_block, 0 };
+				remaining = ZSTD_compressStream2(m_zstd, &out, &input, mode);
+				output.resize(old_size + out.pos);
+
+				if (ZSTD_isError(remaining))
+					return FALSE;
+			}
+			while (finish ? remaining != 0 : input.pos < input.size);
+
+			return TRUE;
+		}
+#endif // KYHTTP_USE_ZSTD
+
+#if !defined(KYHTTP_USE_ZLIB) && !defined(KYHTTP_USE_ZSTD)
+		// no encoder built (Begin failed before)
+		(void)data;
+		(void)nsize;
+		(void)finish;
+		(void)output;
+		(void)out_block;
+#endif
+		return FALSE;
+	}
+
+public:
+	/******************************************************************************
+	*! @brief  : start new compressed stream (reuse encoder for next stream)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : TRUE : ok / FALSE : encoding is not built or init failed
+	******************************************************************************/
+	BOOL Begin()
+	{
+#ifdef KYHTTP_USE_ZLIB
+		if (m_encoding == KY_HTTP_ENCODING_GZIP)
+		{
+			if (m_started)
+				return deflateReset(&m_zstream) == Z_OK ? TRUE : FALSE;
+
+			// 15 + 16 : gzip wrapper
+			int level = (m_level < 0) ? Z_DEFAULT_COMPRESSION : m_level;
+			m_started = deflateInit2(&m_zstream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+			return m_started;
+		}
+#endif // KYHTTP_USE_ZLIB
+
+#ifdef KYHTTP_USE_ZSTD
+		if (m_encoding == KY_HTTP_ENCODING_ZSTD)
+		{
+			if (!m_zstd)
+			{
+				m_zstd = ZSTD_createCCtx();
+				if (!m_zstd)
+					return FALSE;
+
+				int level = (m_level < 0) ? ZSTD_CLEVEL_DEFAULT : m_level;
+				ZSTD_CCtx_setParameter(m_zstd, ZSTD_c_compressionLevel, level);
+			}
+
+			ZSTD_CCtx_reset(m_zstd, ZSTD_reset_session_only);
+			m_started = TRUE;
+			return TRUE;
+		}
+#endif // KYHTTP_USE_ZSTD
+
+		KY_HTTP_LOG_ERROR("Content encoding %s is not built (KYHTTP_USE_ZLIB / KYHTTP_USE_ZSTD).",
+						  get_content_encoding_name(m_encoding));
+		return FALSE;
+	}
+
+	BOOL Update(IN const char* data, IN size_t nsize, OUT HttpBuffer& output)
+	{
+		if (nsize == 0)
+			return TRUE;
+
+		return this->Encode(data, nsize, FALSE, output);
+	}
+
+	BOOL Finish(OUT HttpBuffer& output)
+	{
+		return this->Encode(NULL, 0, TRUE, output);
+	}
+
+	HttpContentEncoding GetEncoding() const
+	{
+		return m_encoding;
+	}
+
+	/******************************************************************************
+	*! @brief  : compress whole buffer
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : TRUE : ok / FALSE : failed (output is not valid)
+	******************************************************************************/
+	BOOL EncodeBuffer(IN const char* data, IN size_t nsize, OUT HttpBuffer& output)
+	{
+		output.clear();
+		output.reserve(nsize / 4 + 64);
+
+		return (this->Begin() && this->Update(data, nsize, output) && this->Finish(output)) ? TRUE : FALSE;
+	}
+};
+
+/*==================================================================================
+* Class HttpCompressStream
+* Compress a stream source while sending (chunked, memory does not depend on size)
+===================================================================================*/
+class HttpCompressStream : public IHttpStreamSource
+{
+public:
+	enum { READ_BLOCK_SIZE = 64 * 1024 };
+
+private:
+	HttpStreamSourcePtr		m_source;
+	HttpContentEncoder		m_encoder;
+
+	std::unique_ptr<char[]> m_read_block;
+	HttpBuffer				m_pending;		// compressed data not yet read by curl
+	size_t					m_pending_pos;
+	BOOL					m_finished;
+
+public:
+	HttpCompressStream(IN HttpStreamSourcePtr source, IN HttpContentEncoding encoding, IN int level = -1) :
+		m_source(source), m_encoder(encoding, level),
+		m_read_block(new char[READ_BLOCK_SIZE]),
+		m_pending_pos(0), m_finished(FALSE)
+	{
+
+	}
+
+	/******************************************************************************
+	*! @brief  : estimate compressed ratio from beginning of source
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : compressed / original (1.0 : empty or failed)
+	*! @note   : first READ_BLOCK_SIZE bytes are read one more time
+	******************************************************************************/
+	double ProbeRatio()
+	{
+		double ratio = 1.0;
+
+		size_t nread = 0;
+		if (m_source && m_source->Rewind() && m_source->Read(m_read_block.get(), READ_BLOCK_SIZE, nread) && nread > 0)
+		{
+			HttpBuffer probe;
+			if (m_encoder.EncodeBuffer(m_read_block.get(), nread, probe))
+				ratio = (double)probe.length() / (double)nread;
+		}
+		return ratio;
+	}
+
+	virtual BOOL Rewind()
+	{
+		m_pending.clear();
+		m_pending_pos = 0;
+		m_finished	  = FALSE;
+
+		return (m_source && m_source->Rewind() && m_encoder.Begin()) ? TRUE : FALSE;
+	}
+
+	virtual BOOL Read(OUT char* buffer, IN size_t nsize, OUT size_t& nread)
+	{
+		nread = 0;
+
+		// encoder can return nothing for a block -> read until output or end
+		while (m_pending_pos >= m_pending.length() && !m_finished)
+		{
+			m_pending.clear();
+			m_pending_pos = 0;
+
+			size_t nsource = 0;
+			if (!m_source->Read(m_read_block.get(), READ_BLOCK_SIZE, nsource))
+				return FALSE;
+
+			if (nsource == 0)
+			{
+				m_finished = TRUE;
+				if (!m_encoder.Finish(m_pending))
+					return FALSE;
+			}
+			else if (!m_encoder.Update(m_read_block.get(), nsource, m_pending))
+			{
+				return FALSE;
+			}
+		}
+
+		nread = m_pending.length() - m_pending_pos;
+		if (nread > nsize)
+			nread = nsize;
+
+		memcpy(buffer, (char*)m_pending.buffer() + m_pending_pos, nread);
+		m_pending_pos += nread;
+
+		return TRUE;
+	}
+
+	// compressed size is unknown -> chunked
+	virtual curl_off_t Size() const
+	{
+		return -1;
+	}
+};
+
+__END___NAMESPACE__
@@ -0,0 +1,591 @@
+/*!**********************************************************************
+* @copyright Copyright (C) 2022 thuong.nv -email: mark.ngo@kohyoung.com.\n
+*            All rights reserved.
+*************************************************************************
+* @file     kyhttp_eventloop.h
+* @date     Oct 17, 2026
+* @brief    HTTP client libcurl implementation file.
+*
+** Event loop for curl_multi_socket_action (sockets, timers, wakeup)
+*************************************************************************/
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <curl/curl.h>
+
+// Linux : epoll + timerfd + eventfd | Windows (or KYHTTP_EVENT_LOOP_POLL) : WSAPoll / poll
+#if defined(__linux__) && !defined(KYHTTP_EVENT_LOOP_POLL)
+#define KYHTTP_EVENT_LOOP_EPOLL
+#endif // __linux__
+
+#if defined(KYHTTP_EVENT_LOOP_EPOLL)
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+#elif !defined(_WIN32)
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#endif // KYHTTP_EVENT_LOOP_EPOLL
+
+#include "kyhttpdef.h"
+#include "kyhttp_logger.h"
+
+__BEGIN_NAMESPACE__
+
+class HttpEventLoop;
+typedef std::shared_ptr<HttpEventLoop> HttpEventLoopPtr;
+
+enum HttpIoEvent
+{
+	KY_HTTP_IO_READ		= 0x01,
+	KY_HTTP_IO_WRITE	= 0x02,
+	KY_HTTP_IO_ERROR	= 0x04, // ready events only (error, hang up)
+};
+
+typedef std::function<void(curl_socket_t sock, unsigned int events)> HttpIoFunc; // events : HttpIoEvent
+typedef std::function<void()>										 HttpTaskFunc;
+
+/*==================================================================================
+* Class HttpEventLoop
+* Single thread reactor : sockets, one queue for all timers (curl timer and
+* application timers), wakeup for posted tasks.
+*
+* Linux   : epoll, timerfd, eventfd -> cost per wakeup = ready sockets + expired timers
+* Windows : WSAPoll, loopback socket for wakeup -> cost per wakeup = watched sockets
+*			(no epoll on Windows ; KYHTTP_EVENT_LOOP_POLL selects it on Linux too)
+*
+* Watch / Unwatch / AddTimer / CancelTimer : call on loop thread (or before Run)
+* Post / Wakeup / Stop						: thread-safe
+*
+* Embed in user reactor : Linux    -> watch GetFd(), call RunOnce(0) when readable
+*						  other    -> call RunOnce(timeout) from user loop, GetTimeout()
+===================================================================================*/
+class HttpEventLoop
+{
+	typedef std::chrono::steady_clock					clock;
+	typedef std::multimap<clock::time_point, uint64_t>	TIMER_QUEUE;
+
+	struct HttpTimer
+	{
+		HttpTaskFunc			m_func;
+		long					m_interval_ms;	// > 0 : repeat timer
+		TIMER_QUEUE::iterator	m_pos;
+	};
+
+	struct HttpWatcher
+	{
+		unsigned int			m_events;		// HttpIoEvent
+		HttpIoFunc				m_func;
+	};
+
+#if defined(_WIN32)
+	typedef WSAPOLLFD		HttpPollFd;
+#elif !defined(KYHTTP_EVENT_LOOP_EPOLL)
+	typedef struct pollfd	HttpPollFd;
+#endif // _WIN32
+
+private:
+#if defined(KYHTTP_EVENT_LOOP_EPOLL)
+	int										m_epoll_fd;
+	int										m_timer_fd;
+	int										m_wakeup_fd;
+#else
+	curl_socket_t							m_wakeup_sock;	// loopback UDP connected to itself
+	std::vector<HttpPollFd>					m_pollfds;		// rebuilt when watchers change
+	bool									m_pollfds_changed;
+#endif // KYHTTP_EVENT_LOOP_EPOLL
+
+	std::atomic<bool>						m_running;
+	std::atomic<bool>						m_stop;
+	std::atomic<std::thread::id>			m_loop_thread;
+
+	std::unordered_map<curl_socket_t, HttpWatcher> m_watchers;
+
+	TIMER_QUEUE								m_timer_queue;
+	std::unordered_map<uint64_t, HttpTimer>	m_timers;
+	uint64_t								m_timer_id;
+
+	std::mutex								m_task_lock;
+	std::vector<HttpTaskFunc>				m_tasks;
+
+public:
+#if defined(KYHTTP_EVENT_LOOP_EPOLL)
+	HttpEventLoop() : m_epoll_fd(-1),
+		m_timer_fd(-1), m_wakeup_fd(-1),
+		m_running(false),
+		m_stop(false),
+		m_timer_id(0)
+	{
+		m_epoll_fd	= epoll_create1(EPOLL_CLOEXEC);
+		m_timer_fd	= timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+		m_wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+		this->EpollControl(EPOLL_CTL_ADD, m_timer_fd, EPOLLIN);
+		this->EpollControl(EPOLL_CTL_ADD, m_wakeup_fd, EPOLLIN);
+	}
+
+	~HttpEventLoop()
+	{
+		if (m_wakeup_fd >= 0) close(m_wakeup_fd);
+		if (m_timer_fd  >= 0) close(m_timer_fd);
+		if (m_epoll_fd  >= 0) close(m_epoll_fd);
+	}
+#else
+	HttpEventLoop() : m_wakeup_sock(CURL_SOCKET_BAD),
+		m_pollfds_changed(true),
+		m_running(false),
+		m_stop(false),
+		m_timer_id(0)
+	{
+#if defined(_WIN32)
+		WSADATA wsa_data;
+		WSAStartup(MAKEWORD(2, 2), &wsa_data);
+#endif // _WIN32
+		m_wakeup_sock = HttpEventLoop::CreateWakeupSocket();
+
+		if (m_wakeup_sock == CURL_SOCKET_BAD)
+		{
+			KY_HTTP_LOG_ERROR(L"[err] : create wakeup socket failed !");
+		}
+	}
+
+	~HttpEventLoop()
+	{
+		HttpEventLoop::CloseSocket(m_wakeup_sock);
+#if defined(_WIN32)
+		WSACleanup();
+#endif // _WIN32
+	}
+#endif // KYHTTP_EVENT_LOOP_EPOLL
+
+	HttpEventLoop(const HttpEventLoop&) = delete;
+	HttpEventLoop& operator=(const HttpEventLoop&) = delete;
+
+private:
+#if defined(KYHTTP_EVENT_LOOP_EPOLL)
+	bool EpollControl(int op, int fd, unsigned int events)
+	{
+		struct epoll_event ev {};
+		ev.events  = events;
+		ev.data.fd = fd;
+
+		return epoll_ctl(m_epoll_fd, op, fd, &ev) == 0;
+	}
+
+	static unsigned int ToEpollEvents(unsigned int events)
+	{
+		unsigned int epoll_events = 0;
+		if (events & KY_HTTP_IO_READ)  epoll_events |= EPOLLIN;
+		if (events & KY_HTTP_IO_WRITE) epoll_events |= EPOLLOUT;
+		return epoll_events;
+	}
+
+	static unsigned int FromEpollEvents(unsigned int epoll_events)
+	{
+		unsigned int events = 0;
+		if (epoll_events & EPOLLIN)				events |= KY_HTTP_IO_READ;
+		if (epoll_events & EPOLLOUT)			events |= KY_HTTP_IO_WRITE;
+		if (epoll_events & (EPOLLERR | EPOLLHUP)) events |= KY_HTTP_IO_ERROR;
+		return events;
+	}
+#else
+	static void CloseSocket(curl_socket_t sock)
+	{
+		if (sock == CURL_SOCKET_BAD)
+			return;
+#if defined(_WIN32)
+		closesocket(sock);
+#else
+		close(sock);
+#endif // _WIN32
+	}
+
+	// UDP socket bound to loopback and connected to itself : send -> readable
+	static curl_socket_t CreateWakeupSocket()
+	{
+		curl_socket_t sock = socket(AF_INET, SOCK_DGRAM, 0);
+		if (sock == CURL_SOCKET_BAD)
+			return sock;
+
+		struct sockaddr_in addr {};
+		addr.sin_family		 = AF_INET;
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		addr.sin_port		 = 0;
+
+#if defined(_WIN32)
+		int addr_len = (int)sizeof(addr);
+#else
+		socklen_t addr_len = (socklen_t)sizeof(addr);
+#endif // _WIN32
+
+		if (bind(sock, (struct sockaddr*)&addr, addr_len) != 0 ||
+			getsockname(sock, (struct sockaddr*)&addr, &addr_len) != 0 ||
+			connect(sock, (struct sockaddr*)&addr, addr_len) != 0)
+		{
+			HttpEventLoop::CloseSocket(sock);
+			return CURL_SOCKET_BAD;
+		}
+
+#if defined(_WIN32)
+		u_long nonblock = 1;
+		ioctlsocket(sock, FIONBIO, &nonblock);
+#else
+		fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+#endif // _WIN32
+		return sock;
+	}
+
+	static int PollSockets(HttpPollFd* fds, size_t nfds, int timeout_ms)
+	{
+#if defined(_WIN32)
+		return WSAPoll(fds, (ULONG)nfds, timeout_ms);
+#else
+		return poll(fds, (nfds_t)nfds, timeout_ms);
+#endif // _WIN32
+	}
+
+	void UpdatePollFds()
+	{
+		m_pollfds.clear();
+
+		HttpPollFd wakeup {};
+		wakeup.fd	  = m_wakeup_sock;
+		wakeup.events = POLLIN;
+		m_pollfds.push_back(wakeup);
+
+		for (auto& it : m_watchers)
+		{
+			HttpPollFd pfd {};
+			pfd.fd = it.first;
+			if (it.second.m_events & KY_HTTP_IO_READ)  pfd.events |= POLLIN;
+			if (it.second.m_events & KY_HTTP_IO_WRITE) pfd.events |= POLLOUT;
+			m_pollfds.push_back(pfd);
+		}
+
+		m_pollfds_changed = false;
+	}
+
+	static unsigned int FromPollEvents(short revents)
+	{
+		unsigned int events = 0;
+		if (revents & POLLIN)						   events |= KY_HTTP_IO_READ;
+		if (revents & POLLOUT)						   events |= KY_HTTP_IO_WRITE;
+		if (revents & (POLLERR | POLLHUP | POLLNVAL)) events |= KY_HTTP_IO_ERROR;
+		return events;
+	}
+#endif // KYHTTP_EVENT_LOOP_EPOLL
+
+	// timerfd follows the first timer (poll : timeout of RunOnce)
+	void ArmTimer()
+	{
+#if defined(KYHTTP_EVENT_LOOP_EPOLL)
+		struct itimerspec spec {};
+
+		if (!m_timer_queue.empty())
+		{
+			auto delay = m_timer_queue.begin()->first - clock::now();
+			long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(delay).count();
+
+			// 0 disarms timerfd -> expired timer fire as soon as possible
+			if (ns <= 0) ns = 1;
+
+			spec.it_value.tv_sec  = static_cast<time_t>(ns / 1000000000LL);
+			spec.it_value.tv_nsec = static_cast<long>(ns % 1000000000LL);
+		}
+
+		timerfd_settime(m_timer_fd, 0, &spec, NULL);
+#endif // KYHTTP_EVENT_LOOP_EPOLL
+	}
+
+	void ProcessTimers()
+	{
+		auto now = clock::now();
+
+		while (!m_timer_queue.empty() && m_timer_queue.begin()->first <= now)
+		{
+			uint64_t id = m_timer_queue.begin()->second;
+			m_timer_queue.erase(m_timer_queue.begin());
+
+			auto it = m_timers.find(id);
+			if (it == m_timers.end())
+				continue;
+
+			HttpTaskFunc func = it->second.m_func;
+
+			if (it->second.m_interval_ms > 0)
+			{
+				auto deadline = now + std::chrono::milliseconds(it->second.m_interval_ms);
+				it->second.m_pos = m_timer_queue.emplace(deadline, id);
+			}
+			else
+			{
+				m_timers.erase(it);
+			}
+
+			// may add / cancel timer
+			func();
+		}
+
+		this->ArmTimer();
+	}
+
+	void ProcessTasks()
+	{
+#if defined(KYHTTP_EVENT_LOOP_EPOLL)
+		uint64_t counter = 0;
+		ssize_t n = read(m_wakeup_fd, &counter, sizeof(counter));
+		(void)n;
+#else
+		char buffer[64];
+		while (recv(m_wakeup_sock, buffer, (int)sizeof(buffer), 0) > 0) {}
+#endif // KYHTTP_EVENT_LOOP_EPOLL
+
+		std::vector<HttpTaskFunc> tasks;
+		{
+			std::lock_guard<std::mutex> lock(m_task_lock);
+			tasks.swap(m_tasks);
+		}
+
+		for (auto& task : tasks)
+		{
+			task();
+		}
+	}
+
+	void Dispatch(curl_socket_t sock, unsigned int events)
+	{
+		// copy : callback may unwatch itself
+		auto it = m_watchers.find(sock);
+		if (it != m_watchers.end())
+		{
+			HttpIoFunc func = it->second.m_func;
+			func(sock, events);
+		}
+	}
+
+public:
+	/******************************************************************************
+	*! @brief  : watch socket events (add or modify)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	events : KY_HTTP_IO_READ | KY_HTTP_IO_WRITE
+	*! @return : true : ok / false : failed
+	******************************************************************************/
+	bool Watch(curl_socket_t sock, unsigned int events, HttpIoFunc func)
+	{
+		bool exist = m_watchers.find(sock) != m_watchers.end();
+
+		HttpWatcher& watcher = m_watchers[sock];
+		watcher.m_events = events;
+		watcher.m_func	 = func;
+
+#if defined(KYHTTP_EVENT_LOOP_EPOLL)
+		return this->EpollControl(exist ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, sock, ToEpollEvents(events));
+#else
+		(void)exist;
+		m_pollfds_changed = true;
+		return true;
+#endif // KYHTTP_EVENT_LOOP_EPOLL
+	}
+
+	void Unwatch(curl_socket_t sock)
+	{
+		if (m_watchers.erase(sock) == 0)
+			return;
+
+#if defined(KYHTTP_EVENT_LOOP_EPOLL)
+		this->EpollControl(EPOLL_CTL_DEL, sock, 0);
+#else
+		m_pollfds_changed = true;
+#endif // KYHTTP_EVENT_LOOP_EPOLL
+	}
+
+	/******************************************************************************
+	*! @brief  : add one-shot timer (interval_ms > 0 : repeat)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : timer id (use for CancelTimer)
+	******************************************************************************/
+	uint64_t AddTimer(long delay_ms, HttpTaskFunc func, long interval_ms = 0)
+	{
+		uint64_t id = ++m_timer_id;
+		auto deadline = clock::now() + std::chrono::milliseconds(delay_ms < 0 ? 0 : delay_ms);
+
+		HttpTimer& timer	= m_timers[id];
+		timer.m_func		= func;
+		timer.m_interval_ms = interval_ms;
+		timer.m_pos			= m_timer_queue.emplace(deadline, id);
+
+		if (timer.m_pos == m_timer_queue.begin())
+			this->ArmTimer();
+
+		return id;
+	}
+
+	void CancelTimer(uint64_t id)
+	{
+		auto it = m_timers.find(id);
+		if (it == m_timers.end())
+			return;
+
+		m_timer_queue.erase(it->second.m_pos);
+		m_timers.erase(it);
+	}
+
+	// wait (ms) until first timer | -1 : no timer
+	int GetTimeout() const
+	{
+		if (m_timer_queue.empty())
+			return -1;
+
+		auto delay = m_timer_queue.begin()->first - clock::now();
+		long long us = std::chrono::duration_cast<std::chrono::microseconds>(delay).count();
+
+		// round up : do not wake up before the timer expires
+		return (int)std::max<long long>(0, (us + 999) / 1000);
+	}
+
+	// thread-safe : run task on loop thread
+	void Post(HttpTaskFunc task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_task_lock);
+			m_tasks.push_back(task);
+		}
+		this->Wakeup();
+	}
+
+	void Wakeup()
+	{
+#if defined(KYHTTP_EVENT_LOOP_EPOLL)
+		uint64_t one = 1;
+		ssize_t n = write(m_wakeup_fd, &one, sizeof(one));
+		(void)n;
+#else
+		// buffer full : already readable
+		char one = 1;
+		send(m_wakeup_sock, &one, 1, 0);
+#endif // KYHTTP_EVENT_LOOP_EPOLL
+	}
+
+	bool IsInLoopThread() const
+	{
+		return m_loop_thread.load() == std::this_thread::get_id();
+	}
+
+	bool IsRunning() const
+	{
+		return m_running;
+	}
+
+	/******************************************************************************
+	*! @brief  : wait and dispatch ready events once (embed in user reactor)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	timeout_ms : -1 : wait forever (until event, timer or wakeup)
+	*! @return : number of ready events / -1 : error
+	******************************************************************************/
+	int RunOnce(int timeout_ms = -1)
+	{
+		m_loop_thread = std::this_thread::get_id();
+
+#if defined(KYHTTP_EVENT_LOOP_EPOLL)
+		const int max_events = 256;
+		struct epoll_event events[max_events];
+
+		int nready = epoll_wait(m_epoll_fd, events, max_events, timeout_ms);
+
+		for (int i = 0; i < nready; i++)
+		{
+			int fd = events[i].data.fd;
+
+			if (fd == m_timer_fd)
+			{
+				uint64_t expirations = 0;
+				ssize_t n = read(m_timer_fd, &expirations, sizeof(expirations));
+				(void)n;
+
+				this->ProcessTimers();
+			}
+			else if (fd == m_wakeup_fd)
+			{
+				this->ProcessTasks();
+			}
+			else
+			{
+				this->Dispatch(fd, FromEpollEvents(events[i].events));
+			}
+		}
+#else
+		int timer_ms = this->GetTimeout();
+		if (timer_ms >= 0 && (timeout_ms < 0 || timer_ms < timeout_ms))
+			timeout_ms = timer_ms;
+
+		if (m_pollfds_changed)
+			this->UpdatePollFds();
+
+		for (auto& pfd : m_pollfds)
+		{
+			pfd.revents = 0;
+		}
+
+		// m_pollfds is not changed by callbacks (rebuilt on next call)
+		int nready = HttpEventLoop::PollSockets(m_pollfds.data(), m_pollfds.size(), timeout_ms);
+
+		for (size_t i = 0; nready > 0 && i < m_pollfds.size(); i++)
+		{
+			if (m_pollfds[i].revents == 0)
+				continue;
+
+			if (m_pollfds[i].fd == m_wakeup_sock)
+				this->ProcessTasks();
+			else
+				this->Dispatch(m_pollfds[i].fd, FromPollEvents(m_pollfds[i].revents));
+		}
+
+		this->ProcessTimers();
+#endif // KYHTTP_EVENT_LOOP_EPOLL
+
+		return nready;
+	}
+
+	void Run()
+	{
+		m_running = true;
+
+		// stop requested before Run is not lost
+		while (!m_stop.exchange(false))
+		{
+			this->RunOnce(-1);
+		}
+
+		m_running = false;
+	}
+
+	// Run returns after current dispatch
+	void Stop()
+	{
+		m_stop = true;
+		this->Wakeup();
+	}
+
+#if defined(KYHTTP_EVENT_LOOP_EPOLL)
+	// epoll fd readable when loop has work : add it to user reactor and call RunOnce(0)
+	int GetFd() const
+	{
+		return m_epoll_fd;
+	}
+#endif // KYHTTP_EVENT_LOOP_EPOLL
+};
+
+__END___NAMESPACE__
@@ -0,0 +1,339 @@
+/*!**********************************************************************
+* @copyright Copyright (C) 2022 thuong.nv -email: mark.ngo@kohyoung.com.\n
+*            All rights reserved.
+*************************************************************************
+* @file     kyhttp_header.h
+* @date     Oct 17, 2026
+* @brief    HTTP client libcurl implementation file.
+*
+** Indexed response header table (parsed line by line in header callback)
+*************************************************************************/
+#pragma once
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include <Windows.h>
+
+#if (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || __cplusplus >= 201703L
+#include <string_view>
+#define KYHTTP_STRING_VIEW
+#endif
+
+#include "kyhttp_types.h"
+#include "kyhttp_buffer.h"
+
+__BEGIN_NAMESPACE__
+
+// value of header : points to memory of response header (valid while response is not cleared)
+struct HttpHeaderValue
+{
+	const char*	m_data;
+	size_t		m_size;
+
+	HttpHeaderValue() : m_data(NULL), m_size(0) {}
+	HttpHeaderValue(const char* data, size_t size) : m_data(data), m_size(size) {}
+
+	bool		empty() const { return m_size == 0; }
+	explicit	operator bool() const { return m_data != NULL; }	// FALSE : header not found
+	std::string str() const { return m_data ? std::string(m_data, m_size) : std::string(); }
+
+#ifdef KYHTTP_STRING_VIEW
+	operator std::string_view() const { return std::string_view(m_data ? m_data : "", m_size); }
+#endif
+};
+
+/*==================================================================================
+* Class HttpHeaderTable
+* Fields of the last response (hop) : offsets of name / value in header buffer.
+* Buffer is the arena (no string copy), reallocation of buffer does not invalidate fields.
+*
+* Lookup : case-insensitive hash (open addressing), same name -> chain of values.
+* Field and slot vectors keep their capacity -> no allocation once warmed up.
+===================================================================================*/
+class HttpHeaderTable
+{
+private:
+	enum { MIN_SLOT = 32, NO_FIELD = -1 };
+
+	struct HttpHeaderField
+	{
+		size_t		m_name_offset;
+		size_t		m_name_size;
+		size_t		m_value_offset;
+		size_t		m_value_size;
+		unsigned	m_hash;
+		int			m_next;			// next value of same name
+	};
+
+private:
+	const HttpBuffer*				m_buffer;
+	std::vector<HttpHeaderField>	m_fields;
+	std::vector<int>				m_slots;	// first field of name / NO_FIELD
+	size_t							m_hop_offset;
+
+public:
+	HttpHeaderTable(IN const HttpBuffer* buffer) : m_buffer(buffer), m_hop_offset(0)
+	{
+		m_fields.reserve(MIN_SLOT);
+		m_slots.assign(MIN_SLOT, NO_FIELD);
+	}
+
+	HttpHeaderTable(const HttpHeaderTable&) = delete;
+	HttpHeaderTable& operator=(const HttpHeaderTable&) = delete;
+
+private:
+	static char lower(char c)
+	{
+		return (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c;
+	}
+
+	static bool is_space(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+	}
+
+	// FNV-1a of lower case name
+	static unsigned hash_name(const char* name, size_t nsize)
+	{
+		unsigned hash = 2166136261u;
+		for (size_t i = 0; i < nsize; i++)
+		{
+			hash ^= (unsigned char)lower(name[i]);
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	// HttpBuffer keeps raw bytes (void*)
+	const char* buffer_data() const
+	{
+		return static_cast<const char*>(m_buffer->buffer());
+	}
+
+	bool equal_name(const HttpHeaderField& field, const char* name, size_t nsize) const
+	{
+		if (field.m_name_size != nsize)
+			return false;
+
+		const char* field_name = buffer_data() + field.m_name_offset;
+		for (size_t i = 0; i < nsize; i++)
+		{
+			if (lower(field_name[i]) != lower(name[i]))
+				return false;
+		}
+		return true;
+	}
+
+	// slot of name (existing field or empty slot)
+	size_t find_slot(const char* name, size_t nsize, unsigned hash) const
+	{
+		size_t mask = m_slots.size() - 1;
+		size_t slot = hash & mask;
+
+		while (m_slots[slot] != NO_FIELD)
+		{
+			const HttpHeaderField& field = m_fields[m_slots[slot]];
+			if (field.m_hash == hash && equal_name(field, name, nsize))
+				break;
+
+			slot = (slot + 1) & mask;
+		}
+		return slot;
+	}
+
+	// keep load factor <= 1/2
+	void grow_slots()
+	{
+		m_slots.assign(m_slots.size() * 2, NO_FIELD);
+
+		size_t mask = m_slots.size() - 1;
+		for (size_t i = 0; i < m_fields.size(); i++)
+		{
+			// only head of chain is in slots (first field of a name)
+			const HttpHeaderField& field = m_fields[i];
+			size_t slot = field.m_hash & mask;
+			bool exist = false;
+
+			while (m_slots[slot] != NO_FIELD)
+			{
+				if (m_fields[m_slots[slot]].m_hash == field.m_hash &&
+					equal_name(m_fields[m_slots[slot]], buffer_data() + field.m_name_offset, field.m_name_size))
+				{
+					exist = true;
+					break;
+				}
+				slot = (slot + 1) & mask;
+			}
+
+			if (!exist)
+				m_slots[slot] = static_cast<int>(i);
+		}
+	}
+
+	HttpHeaderValue make_value(const HttpHeaderField& field) const
+	{
+		return HttpHeaderValue(buffer_data() + field.m_value_offset, field.m_value_size);
+	}
+
+public:
+	/******************************************************************************
+	*! @brief  : remove all fields (new response / new hop)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	hop_offset : start of the hop in header buffer
+	*! @return : void
+	******************************************************************************/
+	void Reset(IN size_t hop_offset = 0)
+	{
+		m_hop_offset = hop_offset;
+
+		if (!m_fields.empty())
+		{
+			m_fields.clear();
+			std::fill(m_slots.begin(), m_slots.end(), (int)NO_FIELD);
+		}
+	}
+
+	/******************************************************************************
+	*! @brief  : parse one header line already appended to the buffer
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	offset : position of line in buffer
+	*! @parameter:	nsize : length of line (CRLF included)
+	*! @return : void
+	*! @note   : status line (HTTP/...) starts a new hop -> table reset
+	******************************************************************************/
+	void ParseLine(IN size_t offset, IN size_t nsize)
+	{
+		const char* data = buffer_data();
+		const char* line = data + offset;
+
+		if (nsize >= 5 && strncmp(line, "HTTP/", 5) == 0)
+		{
+			this->Reset(offset);
+			return;
+		}
+
+		size_t end = offset + nsize;
+		while (end > offset && is_space(data[end - 1]))
+			end--;
+
+		if (end == offset)
+			return; // blank line : end of headers
+
+		// obsolete line folding : continue value of previous field
+		if (line[0] == ' ' || line[0] == '\t')
+		{
+			if (!m_fields.empty())
+			{
+				HttpHeaderField& last = m_fields.back();
+				last.m_value_size = end - last.m_value_offset;
+			}
+			return;
+		}
+
+		const char* colon = static_cast<const char*>(memchr(line, ':', end - offset));
+		if (!colon || colon == line)
+			return; // malformed -> ignored
+
+		HttpHeaderField field;
+		field.m_name_offset = offset;
+		field.m_name_size	= colon - line;
+
+		size_t value_offset = (colon - data) + 1;
+		while (value_offset < end && is_space(data[value_offset]))
+			value_offset++;
+
+		field.m_value_offset = value_offset;
+		field.m_value_size	 = end - value_offset;
+		field.m_hash		 = hash_name(line, field.m_name_size);
+		field.m_next		 = NO_FIELD;
+
+		int index = static_cast<int>(m_fields.size());
+		m_fields.push_back(field);
+
+		size_t slot = find_slot(line, field.m_name_size, field.m_hash);
+		if (m_slots[slot] == NO_FIELD)
+		{
+			m_slots[slot] = index;
+
+			if (m_fields.size() * 2 > m_slots.size())
+				grow_slots();
+		}
+		else
+		{
+			// multi value : append to the end of chain (keep order of response)
+			int prev = m_slots[slot];
+			while (m_fields[prev].m_next != NO_FIELD)
+				prev = m_fields[prev].m_next;
+
+			m_fields[prev].m_next = index;
+		}
+	}
+
+	/******************************************************************************
+	*! @brief  : value of header (first value if many)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	name : case-insensitive
+	*! @return : HttpHeaderValue / invalid (operator bool false) : not found
+	******************************************************************************/
+	HttpHeaderValue GetHeader(IN const char* name) const
+	{
+		if (!name || m_fields.empty())
+			return HttpHeaderValue();
+
+		size_t nsize = strlen(name);
+		size_t slot = find_slot(name, nsize, hash_name(name, nsize));
+
+		if (m_slots[slot] == NO_FIELD)
+			return HttpHeaderValue();
+
+		return make_value(m_fields[m_slots[slot]]);
+	}
+
+	/******************************************************************************
+	*! @brief  : all values of header (Set-Cookie, Link, ...) in order of response
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	name : case-insensitive
+	*! @return : list of values / empty : not found
+	******************************************************************************/
+	std::vector<HttpHeaderValue> GetHeaders(IN const char* name) const
+	{
+		std::vector<HttpHeaderValue> values;
+		if (!name || m_fields.empty())
+			return values;
+
+		size_t nsize = strlen(name);
+		size_t slot = find_slot(name, nsize, hash_name(name, nsize));
+
+		for (int index = m_slots[slot]; index != NO_FIELD; index = m_fields[index].m_next)
+		{
+			values.push_back(make_value(m_fields[index]));
+		}
+		return values;
+	}
+
+	size_t size() const
+	{
+		return m_fields.size();
+	}
+
+	HttpHeaderValue name(IN size_t index) const
+	{
+		const HttpHeaderField& field = m_fields[index];
+		return HttpHeaderValue(buffer_data() + field.m_name_offset, field.m_name_size);
+	}
+
+	HttpHeaderValue value(IN size_t index) const
+	{
+		return make_value(m_fields[index]);
+	}
+
+	// start of the last hop in header buffer
+	size_t hop_offset() const
+	{
+		return m_hop_offset;
+	}
+};
+
+__END___NAMESPACE__
@@ -0,0 +1,171 @@
+/*!**********************************************************************
+* @copyright Copyright (C) 2022 thuong.nv -email: mark.ngo@kohyoung.com.\n
+*            All rights reserved.
+*************************************************************************
+* @file     kyhttp_hedge.h
+* @date     Oct 17, 2026
+* @brief    HTTP client libcurl implementation file.
+*
+** Hedged GET : duplicate request when first byte is late (tail latency)
+*************************************************************************/
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <Windows.h>
+
+#include "kyhttp_types.h"
+
+__BEGIN_NAMESPACE__
+
+class HttpHedgePolicy;
+typedef std::shared_ptr<HttpHedgePolicy> HttpHedgePolicyPtr;
+
+struct HttpHedgeStats
+{
+	unsigned long long	m_request_count;		// GET can be hedged
+	unsigned long long	m_hedge_count;			// duplicate sent
+	unsigned long long	m_hedge_won_count;		// duplicate finished first
+	unsigned long long	m_rate_denied_count;	// delay passed, hedge refused by rate cap
+	unsigned long long	m_cancel_count;			// loser removed from multi
+};
+
+/*==================================================================================
+* Class HttpHedgePolicy
+* Attach to AsyncHttpClient (AttachHedgePolicy). GET without response sink only.
+*
+* Delay :	fixed, or 0 -> percentile (p95) of recent first byte latencies
+*			(initial delay until enough samples)
+* Rate  :	token bucket, every request adds ratio token, a hedge takes one
+*			-> hedges <= ratio of requests (+ burst)
+===================================================================================*/
+class HttpHedgePolicy
+{
+private:
+	enum { MAX_SAMPLES = 256, MIN_SAMPLES = 20 };
+
+	UINT				m_delay;			// ms | 0 : adaptive
+	UINT				m_initial_delay;	// ms : adaptive without enough samples
+	UINT				m_min_delay;		// ms : adaptive lower bound
+	double				m_percentile;
+
+	double				m_rate;
+	double				m_burst;
+	double				m_tokens;
+
+	std::mutex			m_lock;
+	std::vector<UINT>	m_samples;			// ring of first byte latencies (ms)
+	size_t				m_sample_pos;
+	UINT				m_adaptive_delay;	// computed when samples change
+	BOOL				m_adaptive_dirty;
+	HttpHedgeStats		m_stats;
+
+public:
+	HttpHedgePolicy(IN UINT delay_ms = 0, IN double max_rate = 0.05, IN double burst = 5.0) :
+		m_delay(delay_ms),
+		m_initial_delay(100),
+		m_min_delay(10),
+		m_percentile(0.95),
+		m_rate(max_rate),
+		m_burst(burst),
+		m_tokens(burst),
+		m_sample_pos(0),
+		m_adaptive_delay(100),
+		m_adaptive_dirty(FALSE)
+	{
+		m_samples.reserve(MAX_SAMPLES);
+		memset(&m_stats, 0, sizeof(m_stats));
+	}
+
+	HttpHedgePolicy(const HttpHedgePolicy&) = delete;
+	HttpHedgePolicy& operator=(const HttpHedgePolicy&) = delete;
+
+public:
+	// policy setting : set before the policy is used by clients
+	void SetAdaptive(IN double percentile, IN UINT initial_delay_ms, IN UINT min_delay_ms)
+	{
+		m_percentile	= percentile;
+		m_initial_delay = initial_delay_ms;
+		m_min_delay		= min_delay_ms;
+	}
+
+	/******************************************************************************
+	*! @brief  : wait for first byte before sending the duplicate
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : delay (ms)
+	******************************************************************************/
+	UINT GetDelay()
+	{
+		if (m_delay > 0)
+			return m_delay;
+
+		std::lock_guard<std::mutex> lock(m_lock);
+		if (m_samples.size() < MIN_SAMPLES)
+			return m_initial_delay;
+
+		if (m_adaptive_dirty)
+		{
+			std::vector<UINT> samples(m_samples);
+			size_t nth = (size_t)(m_percentile * (samples.size() - 1));
+			std::nth_element(samples.begin(), samples.begin() + nth, samples.end());
+
+			m_adaptive_delay = std::max(samples[nth], m_min_delay);
+			m_adaptive_dirty = FALSE;
+		}
+		return m_adaptive_delay;
+	}
+
+	// first byte latency of completed request
+	void AddLatency(IN UINT latency_ms)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		if (m_samples.size() < MAX_SAMPLES)
+			m_samples.push_back(latency_ms);
+		else
+			m_samples[m_sample_pos] = latency_ms;
+
+		m_sample_pos = (m_sample_pos + 1) % MAX_SAMPLES;
+		m_adaptive_dirty = TRUE;
+	}
+
+	void OnRequest()
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_stats.m_request_count++;
+		m_tokens = std::min(m_tokens + m_rate, m_burst);
+	}
+
+	// TRUE : duplicate can be sent (token taken)
+	BOOL TryHedge()
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		if (m_tokens < 1.0)
+		{
+			m_stats.m_rate_denied_count++;
+			return FALSE;
+		}
+
+		m_tokens -= 1.0;
+		m_stats.m_hedge_count++;
+		return TRUE;
+	}
+
+	void CountFinish(IN BOOL hedge_won)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_stats.m_cancel_count++;
+		if (hedge_won)
+			m_stats.m_hedge_won_count++;
+	}
+
+	HttpHedgeStats GetStats()
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		return m_stats;
+	}
+};
+
+__END___NAMESPACE__
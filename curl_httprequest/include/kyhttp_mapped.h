@@ -0,0 +1,277 @@
+/*!**********************************************************************
+* @copyright Copyright (C) 2022 thuong.nv -email: mark.ngo@kohyoung.com.\n
+*            All rights reserved.
+*************************************************************************
+* @file     kyhttp_mapped.h
+* @date     Oct 17, 2026
+* @brief    HTTP client libcurl implementation file.
+*
+** Read-only memory mapped file shared between requests (upload no copy)
+*************************************************************************/
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <Windows.h>
+#include <curl/curl.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif // _WIN32
+
+#include "kyhttp_types.h"
+#include "kyhttp_utils.h"
+#include "kyhttp_logger.h"
+
+__BEGIN_NAMESPACE__
+
+class MappedFile;
+typedef std::shared_ptr<MappedFile> MappedFilePtr;
+
+// identity of file content : file regenerated / modified -> new mapping
+struct MappedFileId
+{
+	ULONGLONG	m_device;	// volume serial | st_dev
+	ULONGLONG	m_index;	// file index | st_ino
+	ULONGLONG	m_size;
+	ULONGLONG	m_mtime;	// last write time (FILETIME | ns)
+
+	bool operator==(const MappedFileId& other) const
+	{
+		return m_device == other.m_device && m_index == other.m_index &&
+			   m_size == other.m_size && m_mtime == other.m_mtime;
+	}
+};
+
+/*==================================================================================
+* Class MappedFile
+* Whole file mapped read-only. Unmapped when the last owner releases it.
+* Use MappedFile::Open : same path and same file (identity, size, last write time)
+* -> same mapping (one page-cache copy for all concurrent requests).
+* File replaced or modified -> next Open maps it again, old mapping stays valid
+* for its owners (POSIX : truncated in place while mapped -> SIGBUS on read).
+===================================================================================*/
+class MappedFile
+{
+private:
+	std::wstring	m_path;
+	const char*		m_data;
+	size_t			m_size;
+	MappedFileId	m_id;
+
+#if defined(_WIN32)
+	HANDLE			m_file;
+	HANDLE			m_mapping;
+#endif // _WIN32
+
+private:
+	MappedFile(IN const wchar_t* path) : m_path(path),
+		m_data(NULL), m_size(0), m_id()
+#if defined(_WIN32)
+		, m_file(INVALID_HANDLE_VALUE), m_mapping(NULL)
+#endif // _WIN32
+	{
+
+	}
+
+#if defined(_WIN32)
+	static BOOL GetFileId(IN HANDLE file, OUT MappedFileId& id)
+	{
+		BY_HANDLE_FILE_INFORMATION info;
+		if (!GetFileInformationByHandle(file, &info))
+			return FALSE;
+
+		id.m_device = info.dwVolumeSerialNumber;
+		id.m_index	= (static_cast<ULONGLONG>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+		id.m_size	= (static_cast<ULONGLONG>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+		id.m_mtime	= (static_cast<ULONGLONG>(info.ftLastWriteTime.dwHighDateTime) << 32) | info.ftLastWriteTime.dwLowDateTime;
+		return TRUE;
+	}
+#else
+	static void GetFileId(IN const struct stat& st, OUT MappedFileId& id)
+	{
+		id.m_device = static_cast<ULONGLONG>(st.st_dev);
+		id.m_index	= static_cast<ULONGLONG>(st.st_ino);
+		id.m_size	= static_cast<ULONGLONG>(st.st_size);
+		id.m_mtime	= static_cast<ULONGLONG>(st.st_mtim.tv_sec) * 1000000000ULL + static_cast<ULONGLONG>(st.st_mtim.tv_nsec);
+	}
+#endif // _WIN32
+
+	// identity of file at path now (not opened for read : writers are not blocked)
+	static BOOL QueryFileId(IN const wchar_t* path, OUT MappedFileId& id)
+	{
+#if defined(_WIN32)
+		HANDLE file = CreateFileW(path, FILE_READ_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+								  NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return FALSE;
+
+		BOOL ret = GetFileId(file, id);
+		CloseHandle(file);
+		return ret;
+#else
+		std::string file_path = kyhttp::convert_wc_to_string(path);
+
+		struct stat st;
+		if (stat(file_path.c_str(), &st) != 0)
+			return FALSE;
+
+		GetFileId(st, id);
+		return TRUE;
+#endif // _WIN32
+	}
+
+	BOOL Map()
+	{
+#if defined(_WIN32)
+		// FILE_SHARE_DELETE : file in use can be renamed away while mapped
+		m_file = CreateFileW(m_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+							 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (m_file == INVALID_HANDLE_VALUE)
+			return FALSE;
+
+		// identity of the mapped handle (path can be replaced after)
+		if (!GetFileId(m_file, m_id))
+			return FALSE;
+
+		m_size = static_cast<size_t>(m_id.m_size);
+		if (m_size == 0)
+			return TRUE; // empty file can not be mapped
+
+		m_mapping = CreateFileMappingW(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (!m_mapping)
+			return FALSE;
+
+		m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+		return m_data ? TRUE : FALSE;
+#else
+		std::string path = kyhttp::convert_wc_to_string(m_path.c_str());
+
+		int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0)
+			return FALSE;
+
+		struct stat st;
+		if (fstat(fd, &st) != 0)
+		{
+			close(fd);
+			return FALSE;
+		}
+
+		GetFileId(st, m_id);
+
+		m_size = static_cast<size_t>(st.st_size);
+		if (m_size == 0)
+		{
+			close(fd);
+			return TRUE;
+		}
+
+		// mapping keeps the file referenced -> fd not needed
+		void* data = mmap(NULL, m_size, PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+
+		if (data == MAP_FAILED)
+			return FALSE;
+
+		madvise(data, m_size, MADV_SEQUENTIAL);
+		m_data = static_cast<const char*>(data);
+		return TRUE;
+#endif // _WIN32
+	}
+
+	void Unmap()
+	{
+#if defined(_WIN32)
+		if (m_data)	   UnmapViewOfFile(m_data);
+		if (m_mapping) CloseHandle(m_mapping);
+		if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+
+		m_mapping = NULL;
+		m_file	  = INVALID_HANDLE_VALUE;
+#else
+		if (m_data)
+			munmap(const_cast<char*>(m_data), m_size);
+#endif // _WIN32
+		m_data = NULL;
+		m_size = 0;
+	}
+
+	struct Registry
+	{
+		std::mutex								 m_lock;
+		std::map<std::wstring, std::weak_ptr<MappedFile>> m_files;
+	};
+
+	static Registry& GetRegistry()
+	{
+		static Registry registry;
+		return registry;
+	}
+
+public:
+	~MappedFile()
+	{
+		this->Unmap();
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/******************************************************************************
+	*! @brief  : map file (or get the mapping already opened for the same path and file)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	path : file path
+	*! @return : MappedFilePtr / nullptr : open or map failed
+	*! @note   : regenerate file by writing a new file and renaming it (file in use is
+	*!			 not modified in place). Windows : a mapped file can be renamed but not
+	*!			 deleted or replaced -> rename old file away, then new file to path
+	******************************************************************************/
+	static MappedFilePtr Open(IN const wchar_t* path)
+	{
+		Registry& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock(registry.m_lock);
+
+		auto it = registry.m_files.find(path);
+		if (it != registry.m_files.end())
+		{
+			MappedFilePtr mapped = it->second.lock();
+			MappedFileId  file_id;
+
+			// stale : file replaced / modified since it was mapped
+			if (mapped && QueryFileId(path, file_id) && file_id == mapped->m_id)
+				return mapped;
+		}
+
+		MappedFilePtr mapped(new MappedFile(path));
+		if (!mapped->Map())
+		{
+			KY_HTTP_LOG_ERROR(L"[MappedFile] Map file failed: %ls", path);
+			return nullptr;
+		}
+
+		// remove expired entries
+		for (auto iter = registry.m_files.begin(); iter != registry.m_files.end();)
+		{
+			if (iter->second.expired())
+				iter = registry.m_files.erase(iter);
+			else
+				++iter;
+		}
+
+		registry.m_files[path] = mapped;
+		return mapped;
+	}
+
+	const char* data() const { return m_data; }
+	size_t		size() const { return m_size; }
+
+	const std::wstring& path() const { return m_path; }
+};
+
+__END___NAMESPACE__
@@ -0,0 +1,295 @@
+/*!**********************************************************************
+* @copyright Copyright (C) 2022 thuong.nv -email: mark.ngo@kohyoung.com.\n
+*            All rights reserved.
+*************************************************************************
+* @file     kyhttp_retry.h
+* @date     Oct 17, 2026
+* @brief    HTTP client libcurl implementation file.
+*
+** Retry policy : decorrelated jitter backoff, retry status, retry budget by host
+*************************************************************************/
+#pragma once
+
+#include <set>
+#include <mutex>
+#include <memory>
+#include <random>
+#include <string>
+#include <algorithm>
+#include <unordered_map>
+#include <Windows.h>
+#include <curl/curl.h>
+
+#include "kyhttp_types.h"
+
+__BEGIN_NAMESPACE__
+
+class HttpRetryPolicy;
+typedef std::shared_ptr<HttpRetryPolicy> HttpRetryPolicyPtr;
+
+// result of one attempt given to the policy
+struct HttpRetryContext
+{
+	HttpMethod		m_method;
+	std::string		m_origin;		// scheme://host:port (budget key)
+	CURLcode		m_curl_code;
+	LONG			m_status;		// 0 : no response
+	LONGLONG		m_retry_after;	// Retry-After (ms) | -1 : no header
+	UINT			m_retry;		// retries done for the request
+	UINT			m_last_delay;	// delay before last retry (ms) | 0 : first attempt
+};
+
+struct HttpRetryStats
+{
+	unsigned long long	m_request_count;	// first attempts
+	unsigned long long	m_retry_count;
+	unsigned long long	m_budget_denied_count;	// retry refused : budget of host is empty
+	unsigned long long	m_delay_total;		// ms
+};
+
+/*==================================================================================
+* Class HttpRetryPolicy
+* Attach to HttpClient / AsyncHttpClient (AttachRetryPolicy), share one policy
+* between clients to share the budget.
+*
+* Retry :	connect failed (nothing sent)			-> any method
+*			timeout, send / receive error, status	-> GET | POST if SetRetryPost(TRUE)
+* Delay :	decorrelated jitter min(max, random(base, last * 3)), at least Retry-After
+* Budget :	token bucket by host, every request adds ratio token, a retry takes one
+*			-> retries <= ratio of requests (+ capacity burst)
+*
+* Override IsRetryError / IsRetryStatus / ShouldRetry for custom rule.
+===================================================================================*/
+class HttpRetryPolicy
+{
+protected:
+	UINT				m_max_retry;
+	UINT				m_base_delay;		// ms
+	UINT				m_max_delay;		// ms
+	UINT				m_max_retry_after;	// ms : Retry-After longer -> no retry
+	BOOL				m_retry_post;
+	std::set<LONG>		m_retry_status;
+
+	double				m_budget_ratio;		// <= 0 : no budget
+	double				m_budget_capacity;
+
+	std::mutex			m_lock;
+	std::unordered_map<std::string, double> m_budget; // tokens by origin
+	std::mt19937		m_random;
+	HttpRetryStats		m_stats;
+
+public:
+	HttpRetryPolicy(IN UINT max_retry = 3, IN UINT base_delay_ms = 100, IN UINT max_delay_ms = 10000) :
+		m_max_retry(max_retry),
+		m_base_delay(base_delay_ms > 0 ? base_delay_ms : 1),
+		m_max_delay(max_delay_ms),
+		m_max_retry_after(30000),
+		m_retry_post(FALSE),
+		m_retry_status({ HttpStatusCode::TOO_MANY_REQUESTS, HttpStatusCode::SERVICE_UNAVAILABLE }),
+		m_budget_ratio(0.1),
+		m_budget_capacity(10.0),
+		m_random(std::random_device()())
+	{
+		memset(&m_stats, 0, sizeof(m_stats));
+	}
+
+	virtual ~HttpRetryPolicy() {}
+
+	HttpRetryPolicy(const HttpRetryPolicy&) = delete;
+	HttpRetryPolicy& operator=(const HttpRetryPolicy&) = delete;
+
+protected:
+	// lock held
+	UINT NextDelay(IN UINT last_delay)
+	{
+		unsigned long long upper = (unsigned long long)std::max(last_delay, m_base_delay) * 3;
+		std::uniform_int_distribution<unsigned long long> distribution(m_base_delay, upper);
+
+		return (UINT)std::min<unsigned long long>(distribution(m_random), m_max_delay);
+	}
+
+	// lock held
+	BOOL TakeBudget(IN const std::string& origin)
+	{
+		if (m_budget_ratio <= 0.0)
+			return TRUE;
+
+		auto it = m_budget.find(origin);
+		double& tokens = (it != m_budget.end()) ? it->second : (m_budget[origin] = m_budget_capacity);
+
+		if (tokens < 1.0)
+			return FALSE;
+
+		tokens -= 1.0;
+		return TRUE;
+	}
+
+public:
+	// send again after network error
+	virtual BOOL IsRetryError(IN CURLcode code, IN HttpMethod method) const
+	{
+		switch (code)
+		{
+		case CURLE_COULDNT_RESOLVE_HOST:
+		case CURLE_COULDNT_CONNECT:
+			return TRUE; // request was not sent
+
+		case CURLE_OPERATION_TIMEDOUT:
+		case CURLE_SEND_ERROR:
+		case CURLE_RECV_ERROR:
+		case CURLE_GOT_NOTHING:
+			return (method == HttpMethod::GET || m_retry_post) ? TRUE : FALSE;
+
+		default:
+			return FALSE;
+		}
+	}
+
+	virtual BOOL IsRetryStatus(IN LONG status) const
+	{
+		return m_retry_status.count(status) ? TRUE : FALSE;
+	}
+
+	/******************************************************************************
+	*! @brief  : new request to host (add budget token)
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	origin : scheme://host:port
+	*! @return : void
+	******************************************************************************/
+	virtual void OnRequest(IN const std::string& origin)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_stats.m_request_count++;
+
+		if (m_budget_ratio <= 0.0)
+			return;
+
+		auto it = m_budget.find(origin);
+		if (it == m_budget.end())
+			m_budget[origin] = m_budget_capacity;
+		else
+			it->second = std::min(it->second + m_budget_ratio, m_budget_capacity);
+	}
+
+	/******************************************************************************
+	*! @brief  : decide retry of failed attempt
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	context : result of the attempt
+	*! @parameter:	delay_ms : [out] wait before sending again
+	*! @return : TRUE : retry / FALSE : give result to caller
+	******************************************************************************/
+	virtual BOOL ShouldRetry(IN const HttpRetryContext& context, OUT UINT& delay_ms)
+	{
+		delay_ms = 0;
+
+		if (context.m_retry >= m_max_retry)
+			return FALSE;
+
+		if (context.m_curl_code != CURLE_OK)
+		{
+			if (!this->IsRetryError(context.m_curl_code, context.m_method))
+				return FALSE;
+		}
+		else
+		{
+			if (!this->IsRetryStatus(context.m_status))
+				return FALSE;
+
+			if (context.m_method != HttpMethod::GET && !m_retry_post)
+				return FALSE;
+
+			if (context.m_retry_after > (LONGLONG)m_max_retry_after)
+				return FALSE;
+		}
+
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		if (!this->TakeBudget(context.m_origin))
+		{
+			m_stats.m_budget_denied_count++;
+			return FALSE;
+		}
+
+		delay_ms = this->NextDelay(context.m_last_delay);
+		if (context.m_retry_after > (LONGLONG)delay_ms)
+			delay_ms = (UINT)context.m_retry_after;
+
+		m_stats.m_retry_count++;
+		m_stats.m_delay_total += delay_ms;
+		return TRUE;
+	}
+
+	// policy setting : set before the policy is used by clients
+	void SetMaxRetry(IN UINT max_retry)			{ m_max_retry = max_retry; }
+	void SetMaxRetryAfter(IN UINT max_ms)		{ m_max_retry_after = max_ms; }
+	UINT GetMaxRetryAfter() const				{ return m_max_retry_after; }
+	void SetRetryPost(IN BOOL retry_post)		{ m_retry_post = retry_post; }
+	void AddRetryStatus(IN LONG status)			{ m_retry_status.insert(status); }
+	void ClearRetryStatus()						{ m_retry_status.clear(); }
+
+	void SetDelay(IN UINT base_delay_ms, IN UINT max_delay_ms)
+	{
+		m_base_delay = base_delay_ms > 0 ? base_delay_ms : 1;
+		m_max_delay	 = max_delay_ms;
+	}
+
+	/******************************************************************************
+	*! @brief  : retry budget by host
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @parameter:	ratio : token added by each request (0.1 : retries <= 10% of requests) | <= 0 : off
+	*! @parameter:	capacity : maximum tokens (retry burst, full at first request)
+	*! @return : void
+	******************************************************************************/
+	void SetRetryBudget(IN double ratio, IN double capacity = 10.0)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_budget_ratio	  = ratio;
+		m_budget_capacity = capacity;
+		m_budget.clear();
+	}
+
+	HttpRetryStats GetStats()
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		return m_stats;
+	}
+};
+
+/*==================================================================================
+* Class HttpConnectRetryPolicy
+* Policy of HttpClientOption::m_retry_connet (no policy attached) : same as
+* before retry policy -> send again at once, only after connect failed or timeout
+* (any method), no retry status, no budget.
+===================================================================================*/
+class HttpConnectRetryPolicy : public HttpRetryPolicy
+{
+public:
+	HttpConnectRetryPolicy(IN UINT max_retry) : HttpRetryPolicy(max_retry)
+	{
+		m_retry_status.clear();
+		m_budget_ratio = 0.0;
+	}
+
+	virtual BOOL IsRetryError(IN CURLcode code, IN HttpMethod method) const override
+	{
+		(void)method;
+		return (code == CURLE_OPERATION_TIMEDOUT || code == CURLE_COULDNT_CONNECT) ? TRUE : FALSE;
+	}
+
+	virtual BOOL ShouldRetry(IN const HttpRetryContext& context, OUT UINT& delay_ms) override
+	{
+		delay_ms = 0;
+
+		if (context.m_retry >= m_max_retry || context.m_curl_code == CURLE_OK)
+			return FALSE;
+
+		if (!this->IsRetryError(context.m_curl_code, context.m_method))
+			return FALSE;
+
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_stats.m_retry_count++;
+		return TRUE;
+	}
+};
+
+__END___NAMESPACE__
@@ -0,0 +1,119 @@
+/*!**********************************************************************
+* @copyright Copyright (C) 2022 thuong.nv -email: mark.ngo@kohyoung.com.\n
+*            All rights reserved.
+*************************************************************************
+* @file     kyhttp_share.h
+* @date     Oct 17, 2026
+* @brief    HTTP client libcurl implementation file.
+*
+** Connection, DNS and TLS session pool shared between HttpClient (CURLSH)
+*************************************************************************/
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <curl/curl.h>
+
+#include "kyhttp_types.h"
+#include "kyhttp_logger.h"
+
+__BEGIN_NAMESPACE__
+
+/*==================================================================================
+* Class HttpSharePool
+* Wrap curl_share : every HttpClient attached to the same pool reuses resolved
+* hosts and TLS sessions (and warm connections if enabled), even short-lived clients.
+*
+* DNS / TLS session : safe for clients running on different threads (Global()).
+* Connection : libcurl does not support a connection cache used by concurrent
+*			   threads -> share_connection only for clients of one thread. Not used by
+*			   AsyncHttpClient (multi handle keeps its own connection cache).
+===================================================================================*/
+class HttpSharePool
+{
+private:
+	CURLSH*		m_share;
+	BOOL		m_share_connection;
+	std::mutex	m_lock_data[CURL_LOCK_DATA_LAST];
+
+private:
+	static void HttpShareLockFunc(CURL* handle, curl_lock_data data, curl_lock_access access, void* userptr)
+	{
+		HttpSharePool* pool = static_cast<HttpSharePool*>(userptr);
+
+		if (pool && data >= 0 && data < CURL_LOCK_DATA_LAST)
+		{
+			pool->m_lock_data[data].lock();
+		}
+	}
+
+	static void HttpShareUnlockFunc(CURL* handle, curl_lock_data data, void* userptr)
+	{
+		HttpSharePool* pool = static_cast<HttpSharePool*>(userptr);
+
+		if (pool && data >= 0 && data < CURL_LOCK_DATA_LAST)
+		{
+			pool->m_lock_data[data].unlock();
+		}
+	}
+
+public:
+	// share_connection : TRUE only if all attached clients run on the same thread
+	HttpSharePool(BOOL share_connection  = FALSE,
+				  BOOL share_dns		 = TRUE,
+				  BOOL share_ssl_session = TRUE) : m_share(NULL), m_share_connection(FALSE)
+	{
+		m_share = curl_share_init();
+
+		if (!m_share)
+		{
+			KY_HTTP_LOG_ERROR(L"[err] : init curl_share failed !");
+			return;
+		}
+
+		curl_share_setopt(m_share, CURLSHOPT_LOCKFUNC, &HttpSharePool::HttpShareLockFunc);
+		curl_share_setopt(m_share, CURLSHOPT_UNLOCKFUNC, &HttpSharePool::HttpShareUnlockFunc);
+		curl_share_setopt(m_share, CURLSHOPT_USERDATA, this);
+
+		if (share_connection)
+			m_share_connection = (curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT) == CURLSHE_OK);
+		if (share_dns)
+			curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+		if (share_ssl_session)
+			curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+	}
+
+	~HttpSharePool()
+	{
+		// all attached easy handles must be cleaned up before (HttpClient keep pool alive)
+		curl_share_cleanup(m_share);
+		m_share = NULL;
+	}
+
+	HttpSharePool(const HttpSharePool&) = delete;
+	HttpSharePool& operator=(const HttpSharePool&) = delete;
+
+public:
+	CURLSH* Handle() const
+	{
+		return m_share;
+	}
+
+	BOOL IsShareConnection() const
+	{
+		return m_share_connection;
+	}
+
+	/******************************************************************************
+	*! @brief  : process-wide pool (created on first use) : DNS and TLS session only
+	*! @author : thuong.nv - [Date] : 17/10/2026
+	*! @return : HttpSharePoolPtr
+	******************************************************************************/
+	static HttpSharePoolPtr Global()
+	{
+		static HttpSharePoolPtr global_pool = std::make_shared<HttpSharePool>();
+		return global_pool;
+	}
+};
+
+__END___NAMESPACE__
@@ -0,0 +1,233 @@
+/*!**********************************************************************
+* @copyright Copyright (C) 2022 thuong.nv -email: mark.ngo@kohyoung.com.\n
+*            All rights reserved.
+*************************************************************************
+* @file     kyhttp_sink.h
+* @date     Oct 17, 2026
+* @brief    HTTP client libcurl implementation file.
+*
+** Response sink : consume response body while it is received
+*************************************************************************/
+#pragma once
+
+#include <memory>
+#include <string>
+#include <functional>
+#include <Windows.h>
+
+#include "kyhttp_types.h"
+#include "kyhttp_buffer.h"
+#include "kyhttp_logger.h"
+
+__BEGIN_NAMESPACE__
+
+class IResponseSink;
+typedef std::shared_ptr<IResponseSink> HttpResponseSinkPtr;
+
+/*==================================================================================
+* Class IResponseSink
+* Set by HttpRequest::SetResponseSink. Body goes to the sink instead of
+* HttpResponse::Content() (memory of the response does not grow with body size).
+*
+* OnHeaders  : before first data of a response (once per request)
+* OnData	 : body chunk (FALSE -> abort transfer)
+* OnComplete : transfer done (once per request)
+*
+* Callbacks run on the thread performing the transfer.
+* Body of followed redirect (301) is not passed to the sink.
+* Sink is never restarted : failure after first data -> not retried, error returned to caller.
+===================================================================================*/
+class IResponseSink
+{
+public:
+	virtual ~IResponseSink() {}
+
+	virtual BOOL OnHeaders(IN LONG status, IN const HttpBuffer* header) = 0;
+	virtual BOOL OnData(IN const char* data, IN size_t length) = 0;
+	virtual void OnComplete(IN HttpErrorCode error_code) = 0;
+};
+
+/*==================================================================================
+* Class HttpMemorySink
+* Keep body in memory (same as default behavior, but owned by user)
+===================================================================================*/
+class HttpMemorySink : public IResponseSink
+{
+private:
+	HttpBuffer		m_content;
+	HttpErrorCode	m_error_code;
+
+public:
+	HttpMemorySink() : m_error_code(HttpErrorCode::KY_HTTP_FAILED)
+	{
+
+	}
+
+	virtual BOOL OnHeaders(IN LONG status, IN const HttpBuffer* header)
+	{
+		(void)status;
+		(void)header;
+
+		m_content.clear();
+		return TRUE;
+	}
+
+	virtual BOOL OnData(IN const char* data, IN size_t length)
+	{
+		m_content.append(data, length);
+		return TRUE;
+	}
+
+	virtual void OnComplete(IN HttpErrorCode error_code)
+	{
+		m_error_code = error_code;
+	}
+
+	const HttpBuffer* Content() const
+	{
+		return &m_content;
+	}
+
+	HttpErrorCode GetErrorCode() const
+	{
+		return m_error_code;
+	}
+};
+
+/*==================================================================================
+* Class HttpFileSink
+* Write body to file while it is received (constant memory for large download)
+===================================================================================*/
+class HttpFileSink : public IResponseSink
+{
+private:
+	std::wstring	m_path;
+	FILE*			m_file;
+	ULONGLONG		m_written;
+	BOOL			m_expected_status_only;	// write only when status 200 (SUCCESS)
+	HttpErrorCode	m_error_code;
+
+public:
+	HttpFileSink(IN const wchar_t* path, IN BOOL expected_status_only = FALSE) :
+		m_path(path), m_file(NULL), m_written(0),
+		m_expected_status_only(expected_status_only),
+		m_error_code(HttpErrorCode::KY_HTTP_FAILED)
+	{
+
+	}
+
+	~HttpFileSink()
+	{
+		this->CloseFile();
+	}
+
+private:
+	void CloseFile()
+	{
+		if (m_file)
+		{
+			fclose(m_file);
+			m_file = NULL;
+		}
+	}
+
+public:
+	virtual BOOL OnHeaders(IN LONG status, IN const HttpBuffer* header)
+	{
+		(void)header;
+
+		if (m_expected_status_only && status != HttpStatusCode::SUCCESS)
+		{
+			KY_HTTP_LOG_WARN("File sink : status %d, file is not written.", status);
+			return FALSE;
+		}
+
+		// truncate : existing file is overwritten
+		this->CloseFile();
+		m_written = 0;
+		m_file	  = _wfsopen(m_path.c_str(), L"wb", SH_DENYNO);
+
+		if (!m_file)
+		{
+			KY_HTTP_LOG_ERROR(L"File sink : open file failed : %ls", m_path.c_str());
+			return FALSE;
+		}
+		return TRUE;
+	}
+
+	virtual BOOL OnData(IN const char* data, IN size_t length)
+	{
+		if (!m_file)
+			return FALSE;
+
+		if (fwrite(data, sizeof(char), length, m_file) != length)
+		{
+			KY_HTTP_LOG_ERROR(L"File sink : write file failed : %ls", m_path.c_str());
+			return FALSE;
+		}
+
+		m_written += length;
+		return TRUE;
+	}
+
+	virtual void OnComplete(IN HttpErrorCode error_code)
+	{
+		m_error_code = error_code;
+		this->CloseFile();
+	}
+
+	ULONGLONG GetWrittenSize() const
+	{
+		return m_written;
+	}
+
+	HttpErrorCode GetErrorCode() const
+	{
+		return m_error_code;
+	}
+};
+
+/*==================================================================================
+* Class HttpCallbackSink
+* Pass body chunk to user function
+===================================================================================*/
+class HttpCallbackSink : public IResponseSink
+{
+public:
+	typedef std::function<BOOL(LONG, const HttpBuffer*)>	HeadersFunc;
+	typedef std::function<BOOL(const char*, size_t)>		DataFunc;
+	typedef std::function<void(HttpErrorCode)>				CompleteFunc;
+
+private:
+	HeadersFunc		m_headers_func;
+	DataFunc		m_data_func;
+	CompleteFunc	m_complete_func;
+
+public:
+	HttpCallbackSink(IN DataFunc data_func, IN CompleteFunc complete_func = nullptr,
+					 IN HeadersFunc headers_func = nullptr) :
+		m_headers_func(headers_func),
+		m_data_func(data_func),
+		m_complete_func(complete_func)
+	{
+
+	}
+
+	virtual BOOL OnHeaders(IN LONG status, IN const HttpBuffer* header)
+	{
+		return m_headers_func ? m_headers_func(status, header) : TRUE;
+	}
+
+	virtual BOOL OnData(IN const char* data, IN size_t length)
+	{
+		return m_data_func ? m_data_func(data, length) : TRUE;
+	}
+
+	virtual void OnComplete(IN HttpErrorCode error_code)
+	{
+		if (m_complete_func)
+			m_complete_func(error_code);
+	}
+};
+
+__END___NAMESPACE__
@@ -0,0 +1,268 @@
+/*!**********************************************************************
+* @copyright Copyright (C) 2022 thuong.nv -email: mark.ngo@kohyoung.com.\n
+*            All rights reserved.
+*************************************************************************
+* @file     kyhttp_stream.h
+* @date     Oct 17, 2026
+* @brief    HTTP client libcurl implementation file.
+*
+** Stream source for request body (read by CURLOPT_READFUNCTION)
+*************************************************************************/
+#pragma once
+
+#include <memory>
+#include <string>
+#include <cstdio>
+#include <Windows.h>
+#include <curl/curl.h>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#endif // __linux__
+
+#include "kyhttp_types.h"
+#include "kyhttp_logger.h"
+
+__BEGIN_NAMESPACE__
+
+/*==================================================================================
+* interface IHttpStreamSource
+* Request body read piece by piece while sending (not kept in memory)
+===================================================================================*/
+interface IHttpStreamSource
+{
+	virtual ~IHttpStreamSource() {}
+
+	virtual BOOL		Rewind() = 0;											 // (re)start from beginning : before send, retry, redirect
+	virtual BOOL		Read(OUT char* buffer, IN size_t nsize, OUT size_t& nread) = 0; // nread = 0 : end | FALSE : error
+	virtual curl_off_t	Size() const = 0;										 // -1 : unknown (chunked transfer)
+	virtual void		Release() {}											 // transfer done : free file / buffer (Rewind opens again)
+};
+
+typedef std::shared_ptr<IHttpStreamSource> HttpStreamSourcePtr;
+
+/******************************************************************************
+*! @brief  : curl read / seek callback for IHttpStreamSource (CURLOPT_READFUNCTION, curl_mime_data_cb)
+*! @author : thuong.nv - [Date] : 17/10/2026
+******************************************************************************/
+static size_t HttpStreamReadFunc(char* buffer, size_t size, size_t nitems, void* user_data)
+{
+	IHttpStreamSource* stream = static_cast<IHttpStreamSource*>(user_data);
+
+	size_t nread = 0;
+	if (!stream || !stream->Read(buffer, size * nitems, nread))
+	{
+		KY_HTTP_LOG_ERROR("Read stream content failed.");
+		return CURL_READFUNC_ABORT;
+	}
+	return nread;
+}
+
+static int HttpStreamSeekFunc(void* user_data, curl_off_t offset, int origin)
+{
+	IHttpStreamSource* stream = static_cast<IHttpStreamSource*>(user_data);
+
+	// curl only rewinds to resend (retry, redirect, auth)
+	if (!stream || offset != 0 || origin != SEEK_SET)
+		return CURL_SEEKFUNC_CANTSEEK;
+
+	return stream->Rewind() ? CURL_SEEKFUNC_OK : CURL_SEEKFUNC_FAIL;
+}
+
+/*==================================================================================
+* Class HttpMemoryStream
+* Read cursor on memory not owned by the stream (owner : keep memory alive if set)
+===================================================================================*/
+class HttpMemoryStream : public IHttpStreamSource
+{
+private:
+	const char*					m_data;
+	size_t						m_size;
+	size_t						m_offset;
+	std::shared_ptr<const void> m_owner;
+
+public:
+	HttpMemoryStream(IN const void* data, IN size_t size, IN std::shared_ptr<const void> owner = nullptr) :
+		m_data(static_cast<const char*>(data)), m_size(size), m_offset(0), m_owner(owner)
+	{
+
+	}
+
+	virtual BOOL Rewind()
+	{
+		m_offset = 0;
+		return TRUE;
+	}
+
+	virtual BOOL Read(OUT char* buffer, IN size_t nsize, OUT size_t& nread)
+	{
+		nread = m_size - m_offset;
+		if (nread > nsize)
+			nread = nsize;
+
+		memcpy(buffer, m_data + m_offset, nread);
+		m_offset += nread;
+
+		return TRUE;
+	}
+
+	virtual curl_off_t Size() const
+	{
+		return static_cast<curl_off_t>(m_size);
+	}
+};
+
+/*==================================================================================
+* Class HttpFileStream
+* Read file through a fixed read-ahead buffer : memory does not depend on file size
+* File is opened (deny write) only while sending : closed at end of file / transfer done
+===================================================================================*/
+class HttpFileStream : public IHttpStreamSource
+{
+public:
+	enum { READ_AHEAD_SIZE = 1024 * 1024 };
+
+private:
+	std::wstring			m_path;
+	FILE*					m_file;
+	curl_off_t				m_size;
+	BOOL					m_sequential_hint;
+
+	std::unique_ptr<char[]> m_read_ahead;
+	size_t					m_read_pos;
+	size_t					m_read_len;
+	BOOL					m_eof;		// all data read : file released
+
+public:
+	HttpFileStream(IN const wchar_t* path, IN BOOL sequential_hint = TRUE) :
+		m_path(path), m_file(NULL), m_size(-1),
+		m_sequential_hint(sequential_hint),
+		m_read_pos(0), m_read_len(0), m_eof(FALSE)
+	{
+
+	}
+
+	~HttpFileStream()
+	{
+		this->Close();
+	}
+
+private:
+	void Close()
+	{
+		if (m_file)
+		{
+			fclose(m_file);
+			m_file = NULL;
+		}
+	}
+
+	static curl_off_t GetFileSize(FILE* file)
+	{
+#if defined(_WIN32)
+		_fseeki64(file, 0, SEEK_END);
+		curl_off_t nsize = _ftelli64(file);
+		_fseeki64(file, 0, SEEK_SET);
+#else
+		fseeko(file, 0, SEEK_END);
+		curl_off_t nsize = ftello(file);
+		fseeko(file, 0, SEEK_SET);
+#endif
+		return nsize;
+	}
+
+	BOOL Open()
+	{
+		// S : sequential access cache hint (MSVC)
+#if defined(_WIN32)
+		m_file = _wfsopen(m_path.c_str(), m_sequential_hint ? L"rbS" : L"rb", _SH_DENYWR);
+#else
+		m_file = _wfsopen(m_path.c_str(), L"rb", _SH_DENYWR);
+#endif
+		if (!m_file)
+		{
+			KY_HTTP_LOG_ERROR(L"[FileStream] Open file failed: %ls", m_path.c_str());
+			return FALSE;
+		}
+
+		m_size = GetFileSize(m_file);
+
+#if defined(__linux__)
+		if (m_sequential_hint)
+			posix_fadvise(fileno(m_file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif // __linux__
+
+		if (!m_read_ahead)
+			m_read_ahead.reset(new char[READ_AHEAD_SIZE]);
+
+		return TRUE;
+	}
+
+public:
+	virtual BOOL Rewind()
+	{
+		m_read_pos = 0;
+		m_read_len = 0;
+		m_eof	   = FALSE;
+
+		if (!m_file)
+			return this->Open();
+
+#if defined(_WIN32)
+		return _fseeki64(m_file, 0, SEEK_SET) == 0 ? TRUE : FALSE;
+#else
+		return fseeko(m_file, 0, SEEK_SET) == 0 ? TRUE : FALSE;
+#endif
+	}
+
+	virtual BOOL Read(OUT char* buffer, IN size_t nsize, OUT size_t& nread)
+	{
+		nread = 0;
+
+		if (!m_file)
+			return m_eof;
+
+		// refill read-ahead buffer
+		if (m_read_pos >= m_read_len)
+		{
+			m_read_pos = 0;
+			m_read_len = fread(m_read_ahead.get(), sizeof(char), READ_AHEAD_SIZE, m_file);
+
+			if (m_read_len == 0)
+			{
+				if (ferror(m_file))
+					return FALSE;
+
+				// other writers are not blocked until the response is received
+				m_eof = TRUE;
+				this->Release();
+				return TRUE;
+			}
+		}
+
+		nread = m_read_len - m_read_pos;
+		if (nread > nsize)
+			nread = nsize;
+
+		memcpy(buffer, m_read_ahead.get() + m_read_pos, nread);
+		m_read_pos += nread;
+
+		return TRUE;
+	}
+
+	virtual curl_off_t Size() const
+	{
+		return m_size;
+	}
+
+	virtual void Release()
+	{
+		this->Close();
+
+		m_read_ahead.reset();
+		m_read_pos = 0;
+		m_read_len = 0;
+	}
+};
+
+__END___NAMESPACE__
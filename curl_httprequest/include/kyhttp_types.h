@@ -13,6 +13,7 @@
 #include <Windows.h>
 #include <string>
 #include <memory>
+#include <cctype>
 
 #include "kyhttpdef.h"
 
@@ -40,6 +41,9 @@ typedef std::shared_ptr<HttpRawContent> HttpRawContentPtr;
 class HttpUrlEncodedContent;
 typedef std::shared_ptr<HttpUrlEncodedContent> HttpUrlEncodedContentPtr;
 
+class HttpSharePool;
+typedef std::shared_ptr<HttpSharePool> HttpSharePoolPtr;
+
 class Uri;
 
 
@@ -51,11 +55,13 @@ enum HttpStatusCode
 	NO_CONTENT							= 204, // There is no content to send for this request, but the headers may be useful
 	MOVED_PERMANENTLY					= 301, // The URL of the requested resource has been changed permanently. The new URL is given in the response.
 	SEE_OTHER							= 303, // This response code means that the URI of requested resource has been changed temporarily
+	NOT_MODIFIED						= 304, // Cached version of the resource is still valid (conditional request)
 	BAD_REQUEST							= 400, // The server cannot or will not process the request due to something that is perceived to be a client error 
 	UNAUTHORIZED						= 401, // Although the HTTP standard specifies "unauthorized"
 	FORBIDDEN							= 403, // The client does not have access rights to the content; that is, it is unauthorized, so the server is refusing to give the requested resource
 	NOT_FOUND							= 404, // The server cannot find the requested resource
 	METHOD_NOT_ALLOWED					= 405, // The request method is known by the server but is not supported by the target resource
+	TOO_MANY_REQUESTS					= 429, // The user has sent too many requests in a given amount of time (rate limiting)
 	INTERNAL_SERVER_ERROR				= 500, // The server has encountered a situation it does not know how to handle
 	NOT_IMPLEMENTED						= 501, // The request method is not supported by the server and cannot be handled
 	SERVICE_UNAVAILABLE					= 503, // The server is not ready to handle the request
@@ -78,6 +84,7 @@ enum HttpErrorCode
 	KY_HTTP_CREATEDATA_REQUEST_FAIL		= KY_HTTP_ERR_BEGIN + 0x00000011, // CUSTOM: create request data failed
 	KY_HTTP_INIT_REQUEST_FAIL			= KY_HTTP_ERR_BEGIN + 0x00000012, // CUSTOM: init request failed
 	KY_HTTP_USER_FORCE_STOP				= KY_HTTP_ERR_BEGIN + 0x00000013, // CUSTOM: user force stop
+	KY_HTTP_CIRCUIT_OPEN				= KY_HTTP_ERR_BEGIN + 0x00000014, // CUSTOM: circuit breaker of host is open (not sent)
 };
 
 #define PASS_ERROR_CODE(code, exec) if(code == HttpErrorCode::KY_HTTP_OK) { code = exec;}
@@ -93,6 +100,8 @@ enum ContentType
 	multipart	,
 	raw			,
 	audio		,
+	stream		,	// IHttpStreamSource : read by CURLOPT_READFUNCTION
+	mapped		,	// MappedFile : memory mapped file sent without copy
 };
 
 enum HttpContentType
@@ -177,6 +186,32 @@ enum ProxyType
 	KY_PROXY_SOCKS5  =  CURLPROXY_SOCKS5,
 };
 
+enum HttpVersion
+{
+	KY_HTTP_VERSION_DEFAULT			  = CURL_HTTP_VERSION_NONE,				 // libcurl decide (default)
+	KY_HTTP_VERSION_1_1				  = CURL_HTTP_VERSION_1_1,
+	KY_HTTP_VERSION_2				  = CURL_HTTP_VERSION_2TLS,				 // h2 over TLS (ALPN), HTTP/1.1 for http://
+	KY_HTTP_VERSION_2_PRIOR_KNOWLEDGE = CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE, // h2c without upgrade (local server)
+};
+
+// request body compression (HttpRequest::SetContentEncoding)
+enum HttpContentEncoding
+{
+	KY_HTTP_ENCODING_IDENTITY = 0,	// not compressed
+	KY_HTTP_ENCODING_GZIP,			// build with KYHTTP_USE_ZLIB
+	KY_HTTP_ENCODING_ZSTD,			// build with KYHTTP_USE_ZSTD
+};
+
+// weight of transfer in bandwidth shared by HttpBandwidthGovernor
+enum HttpBandwidthPriority
+{
+	KY_HTTP_PRIORITY_LOW	= 1,	// bulk upload / download
+	KY_HTTP_PRIORITY_NORMAL	= 4,
+	KY_HTTP_PRIORITY_HIGH	= 16,	// latency critical API call
+};
+
+class HttpBandwidthLimiter;
+
 
 struct WebProxy
 {
@@ -207,13 +242,21 @@ struct HttpCookieData
 struct HttpClientOption
 {
 	BOOL	m_show_request = TRUE;			// Show request
-	UINT	m_retry_connet;					// Number of connection attempts if failed
+	UINT	m_retry_connet = 0;				// Number of connection attempts if failed
 	ULONG	m_connect_timout = 0;			// Time-out connect operations after this amount of seconds				- milliseconds
-	ULONG	m_max_download_speed;			// Limit-rate: maximum number of bytes per second to receive			- kb/s
-	ULONG	m_max_upload_speed;				// Limit-rate: maximum number of bytes per second to send				- kb/s
+	ULONG	m_max_download_speed = 0;		// Limit-rate: maximum number of bytes per second to receive			- kb/s
+	ULONG	m_max_upload_speed = 0;			// Limit-rate: maximum number of bytes per second to send				- kb/s
 	BOOL	m_auto_redirect = FALSE;		// automatically send request if response is move MOVED_PERMANENTLY		|TRUE / FALSE
 	BOOL	m_process_cookie = FALSE;		// does not process cookies received									|TRUE / FALSE
 	BOOL	m_get_server_time = FALSE;		// flag get system time information based on response					|TRUE / FALSE
+	BOOL	m_reuse_connection = FALSE;		// keep curl handle alive between requests (connection, DNS, TLS cache) |TRUE / FALSE
+	HttpVersion	m_http_version = KY_HTTP_VERSION_DEFAULT; // HTTP/2 : concurrent requests same host multiplexed on one connection
+	LONG	m_max_concurrent_streams = 100;	// HTTP/2 : maximum streams per connection (AsyncHttpClient)
+	LONG	m_max_host_connections = 0;		// maximum connections per host, over limit transfer is queued (AsyncHttpClient) | 0 : no limit
+	UINT	m_max_content_reserve = 64 * 1024 * 1024; // reserve body by Content-Length up to this size (bytes), bigger grows by chunk | 0 : off
+	BOOL	m_segmented_content = FALSE;	// keep body in pooled chunks (HttpResponse::SegmentedContent) : no copy on growth |TRUE / FALSE
+	BOOL	m_decode_content = TRUE;		// negotiate encodings supported by libcurl (gzip, br, zstd...), body received decoded |TRUE / FALSE
+	HttpBandwidthPriority m_bandwidth_priority = KY_HTTP_PRIORITY_NORMAL; // share of HttpBandwidthGovernor (attached governor only)
 };
 
 struct HttpClientProgress
@@ -226,6 +269,8 @@ struct HttpClientProgress
 
 	double	m_total_download;
 	double	m_total_upload;
+
+	HttpBandwidthLimiter* m_bandwidth = NULL;	// throttled by governor
 };
 
 struct HttpHeaderData
@@ -247,6 +292,7 @@ interface HttpContent
 protected:
 	virtual void* InitContent(IN void* base = NULL) = 0;
 	virtual ContentType GetType() const = 0;
+	virtual void ReleaseContent() {}	// transfer done : free resources kept for sending
 
 	friend class HttpRequest;
 };
@@ -378,9 +424,53 @@ public:
 		return url;
 	}
 
+	// scheme://host[:port] in lower case (Ex: http://192.168.111.247:80)
+	std::string get_origin() const
+	{
+		size_t begin = location.find("://");
+		begin = (begin == std::string::npos) ? 0 : begin + 3;
+
+		size_t end = location.find_first_of("/?#", begin);
+		if (end == std::string::npos)
+			end = location.length();
+
+		// remove user info
+		size_t at = location.rfind('@', end);
+		size_t host_begin = (at != std::string::npos && at >= begin) ? at + 1 : begin;
+
+		std::string origin = location.substr(0, begin) + location.substr(host_begin, end - host_begin);
+		for (auto& c : origin)
+		{
+			c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+		}
+		return origin;
+	}
+
 	friend class HttpClient;
 };
 
+/*==================================================================================
+* Batch request : HttpClient::RequestBatch
+===================================================================================*/
+struct HttpBatchItem
+{
+	HttpMethod			m_method;
+	Uri					m_uri;
+	HttpRequestPtr		m_request;				// nullptr allowed for GET | content must stay alive
+};
+
+struct HttpBatchOption
+{
+	UINT	m_max_in_flight = 8;				// maximum requests running at the same time	| 0 : no limit
+	UINT	m_max_per_host  = 4;				// maximum requests running same origin		| 0 : no limit
+};
+
+struct HttpBatchResult
+{
+	HttpErrorCode		m_error_code;
+	HttpResponsePtr		m_response;
+};
+
 /*==================================================================================
 * Template class ArrayObject : list vector share pointer object
 ===================================================================================*/
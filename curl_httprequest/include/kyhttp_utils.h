@@ -10,6 +10,8 @@
 *************************************************************************/
 #pragma once
 #include <iostream>
+#include <cstring>
+#include <ctime>
 #include <Windows.h>
 
 #include "kyhttpdef.h"
@@ -218,4 +220,216 @@ static std::string second_epoch_to_string(time_t t, const char* format = "%d-%m-
 }
 
 
+/******************************************************************************
+*! @brief  : number of days from 1970-01-01 (proleptic gregorian calendar)
+*! @author : thuong.nv - [Date] : 17/10/2026
+*! @parameter:	month : [1->12] / day : [1->31]
+*! @note   : H. Hinnant days_from_civil (no time zone, no lock as mktime)
+******************************************************************************/
+static long long days_from_civil(IN long long year, IN unsigned month, IN unsigned day)
+{
+	year -= month <= 2;
+	const long long era = (year >= 0 ? year : year - 399) / 400;
+	const unsigned yoe = static_cast<unsigned>(year - era * 400);			 // [0, 399]
+	const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1; // [0, 365]
+	const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;			 // [0, 146096]
+	return era * 146097 + static_cast<long long>(doe) - 719468;
+}
+
+// month of 3 letters (case-insensitive) -> [1->12] / 0 : invalid
+static unsigned http_date_month(IN const char* str)
+{
+	unsigned key = ((unsigned)(str[0] | 0x20) << 16) | ((unsigned)(str[1] | 0x20) << 8) | (unsigned)(str[2] | 0x20);
+	switch (key)
+	{
+	case ('j' << 16) | ('a' << 8) | 'n': return 1;
+	case ('f' << 16) | ('e' << 8) | 'b': return 2;
+	case ('m' << 16) | ('a' << 8) | 'r': return 3;
+	case ('a' << 16) | ('p' << 8) | 'r': return 4;
+	case ('m' << 16) | ('a' << 8) | 'y': return 5;
+	case ('j' << 16) | ('u' << 8) | 'n': return 6;
+	case ('j' << 16) | ('u' << 8) | 'l': return 7;
+	case ('a' << 16) | ('u' << 8) | 'g': return 8;
+	case ('s' << 16) | ('e' << 8) | 'p': return 9;
+	case ('o' << 16) | ('c' << 8) | 't': return 10;
+	case ('n' << 16) | ('o' << 8) | 'v': return 11;
+	case ('d' << 16) | ('e' << 8) | 'c': return 12;
+	default: return 0;
+	}
+}
+
+/******************************************************************************
+*! @brief  : parse HTTP-date (RFC 7231 7.1.1.1) to second epoch (UTC)
+*! @author : thuong.nv - [Date] : 17/10/2026
+*! @parameter:	str : not need null terminated
+*! @parameter:	nsize : length of str
+*! @parameter:	time : [out] second epoch
+*! @return : TRUE : ok / FALSE : invalid format
+*! @note   : IMF-fixdate : Sun, 06 Nov 1994 08:49:37 GMT
+*!			 RFC 850	 : Sunday, 06-Nov-94 08:49:37 GMT
+*!			 asctime	 : Sun Nov  6 08:49:37 1994
+*!			 last string parsed by thread is memoized (same Date for many responses)
+******************************************************************************/
+static BOOL parse_http_date(IN const char* str, IN size_t nsize, OUT time_t& time)
+{
+	struct HttpDateCache
+	{
+		char	m_str[40];
+		size_t	m_size;
+		time_t	m_time;
+	};
+	static thread_local HttpDateCache cache = { {0}, 0, 0 };
+
+	if (!str)
+		return FALSE;
+
+	// trim
+	while (nsize > 0 && (*str == ' ' || *str == '\t'))	{ str++; nsize--; }
+	while (nsize > 0 && (str[nsize - 1] == ' ' || str[nsize - 1] == '\t' ||
+						 str[nsize - 1] == '\r' || str[nsize - 1] == '\n')) { nsize--; }
+
+	if (nsize == 0 || nsize >= sizeof(cache.m_str))
+		return FALSE;
+
+	if (cache.m_size == nsize && memcmp(cache.m_str, str, nsize) == 0)
+	{
+		time = cache.m_time;
+		return TRUE;
+	}
+
+	const char* cur = str;
+	const char* end = str + nsize;
+
+	auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+	auto skip_space = [&]() { while (cur < end && *cur == ' ') cur++; };
+
+	// read 1 -> max_digit digits
+	auto read_number = [&](int max_digit, int& value) -> bool
+	{
+		int ndigit = 0; value = 0;
+		while (cur < end && ndigit < max_digit && is_digit(*cur))
+		{
+			value = value * 10 + (*cur - '0');
+			cur++; ndigit++;
+		}
+		return ndigit > 0;
+	};
+
+	auto read_month = [&](unsigned& month) -> bool
+	{
+		if (end - cur < 3) return false;
+		month = http_date_month(cur);
+		cur += 3;
+		return month != 0;
+	};
+
+	auto read_clock = [&](int& hour, int& minute, int& second) -> bool
+	{
+		if (!read_number(2, hour) || cur >= end || *cur++ != ':') return false;
+		if (!read_number(2, minute) || cur >= end || *cur++ != ':') return false;
+		return read_number(2, second);
+	};
+
+	// day name
+	while (cur < end && ((*cur | 0x20) >= 'a' && (*cur | 0x20) <= 'z'))
+		cur++;
+
+	if (cur >= end)
+		return FALSE;
+
+	int year = 0, day = 0, hour = 0, minute = 0, second = 0;
+	unsigned month = 0;
+
+	if (*cur == ',')
+	{
+		cur++;
+		skip_space();
+
+		if (!read_number(2, day) || cur >= end)
+			return FALSE;
+
+		if (*cur == '-') // RFC 850 : 06-Nov-94
+		{
+			cur++;
+			if (!read_month(month) || cur >= end || *cur++ != '-')
+				return FALSE;
+
+			const char* year_begin = cur;
+			if (!read_number(4, year))
+				return FALSE;
+
+			// 2 digits year : RFC 7231 -> not more than 50 years in the future,
+			// else most recent past year with the same last two digits
+			if (cur - year_begin == 2)
+			{
+				time_t now = ::time(NULL);
+				struct tm now_tm;
+				int current_year = (gmtime_s(&now_tm, &now) == 0) ? now_tm.tm_year + 1900 : 1970;
+
+				year += current_year - current_year % 100;
+				if (year > current_year + 50)
+					year -= 100;
+			}
+		}
+		else // IMF-fixdate : 06 Nov 1994
+		{
+			skip_space();
+			if (!read_month(month))
+				return FALSE;
+
+			skip_space();
+			if (!read_number(4, year))
+				return FALSE;
+		}
+
+		skip_space();
+		if (!read_clock(hour, minute, second))
+			return FALSE;
+
+		skip_space();
+		if (cur < end && !((end - cur == 3) && (memcmp(cur, "GMT", 3) == 0 || memcmp(cur, "UTC", 3) == 0)))
+			return FALSE;
+	}
+	else if (*cur == ' ') // asctime : Nov  6 08:49:37 1994
+	{
+		skip_space();
+		if (!read_month(month))
+			return FALSE;
+
+		skip_space();
+		if (!read_number(2, day))
+			return FALSE;
+
+		skip_space();
+		if (!read_clock(hour, minute, second))
+			return FALSE;
+
+		skip_space();
+		if (!read_number(4, year) || cur != end)
+			return FALSE;
+	}
+	else
+	{
+		return FALSE;
+	}
+
+	static const int days_in_month[] = { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+	if (year < 1900 || day < 1 || day > days_in_month[month - 1] || hour > 23 || minute > 59 || second > 60)
+		return FALSE;
+
+	if (month == 2 && day == 29 && !(year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)))
+		return FALSE;
+
+	if (second == 60) // leap second
+		second = 59;
+
+	time = static_cast<time_t>(days_from_civil(year, month, day) * 86400LL + hour * 3600 + minute * 60 + second);
+
+	memcpy(cache.m_str, str, nsize);
+	cache.m_size = nsize;
+	cache.m_time = time;
+
+	return TRUE;
+}
+
 __END___NAMESPACE__
\ No newline at end of file
@@ -1,4 +1,10 @@
 #include "kyhttp_curl.h"
+#include "kyhttp_async.h"
+
+// co_await demo (coroutine_request_test) : project is built with /std:c++20
+#ifndef KYHTTP_COROUTINE
+#error "kyhttp_apitest needs C++20 coroutines : set /std:c++20 (LanguageStandard stdcpp20)"
+#endif // KYHTTP_COROUTINE
 
 
 #define FOLDER_API_REQUEST_DATA   L"ksmart_api/request/"
@@ -24,6 +30,7 @@ void post_urlencoded_content_usefile(IN		const kyhttp::Uri&		uri,
 
 	// save received data to file
 	request->SetContent(content.get());
+	client->AttachSharePool(kyhttp::HttpSharePool::Global());
 
 	kyhttp::HttpErrorCode err = client->Request(kyhttp::POST, uri, request.get());
 	auto response = client->Response();
@@ -37,12 +44,16 @@ void get_file_to(IN		const kyhttp::Uri&		uri,
 				 IN		kyhttp::HttpClientPtr	client,
 				 IN		const wchar_t*			rev_data_file)
 {
-	kyhttp::HttpErrorCode err = client->Request(kyhttp::GET, uri, nullptr);
-	auto response = client->Response();
+	client->AttachSharePool(kyhttp::HttpSharePool::Global());
 
 	std::wstring path_response_data(FOLDER_API_RESPONSE_DATA);
 	path_response_data.append(rev_data_file);
-	response->SaveToFile(path_response_data.c_str(), FALSE);
+
+	// write to file while receiving (not keep whole file in memory)
+	kyhttp::HttpRequestPtr request = std::make_shared<kyhttp::HttpRequest>();
+	request->SetResponseSink(std::make_shared<kyhttp::HttpFileSink>(path_response_data.c_str()));
+
+	kyhttp::HttpErrorCode err = client->Request(kyhttp::GET, uri, request.get());
 }
 
 void upload_file_to(IN		const kyhttp::Uri& uri,
@@ -52,17 +63,19 @@ void upload_file_to(IN		const kyhttp::Uri& uri,
 {
 	kyhttp::HttpRequestPtr request = std::make_shared<kyhttp::HttpRequest>();
 
-	void* data;
 	std::wstring path_send_data(FOLDER_API_REQUEST_DATA);
 	path_send_data.append(path_file_upload);
-	int file_size = kyhttp::read_data_file(path_send_data.c_str(), &data);
-	char* file_data = static_cast<char*>(data);
 	std::string content_param = "AgentId=\"492F183D-404E-4088-B49C-0A183F5ADA4E\"; AuthToken=\"12923\"; UserId=\"e\"; JobId=\"6226119\"; GroupSeq=\"0\"";
 
+	// mapped file : not read to memory, same file shared between uploads
+	kyhttp::MappedFilePtr mapped = kyhttp::MappedFile::Open(path_send_data.c_str());
+	if (!mapped)
+		return;
+
 	kyhttp::HttpMultipartContentPtr content = std::make_shared<kyhttp::HttpMultipartContent>();
 	
-	content->AddPartFile("file", "job_kyhttp_test.kyjob", file_data, file_size,
-						kyhttp::HttpContentType::application_octet_stream, content_param.c_str());
+	content->AddPartMappedFile("file", "job_kyhttp_test.kyjob", mapped,
+							   kyhttp::HttpContentType::application_octet_stream, content_param.c_str());
 
 	//content->AddPartFile("file", "job_kyhttp_test.kyjob", file_data, file_size,
 	//	kyhttp::Auto, NULL, content_param.c_str());
@@ -211,6 +224,787 @@ void upload_file_multipart()
 }
 
 
+// local stand-in server : python -m http.server 8080 | openssl s_server -accept 8443 -WWW
+double request_latency_avg(IN const char* location, IN BOOL reuse_connection, IN int nrequest)
+{
+	kyhttp::Uri uri;
+	uri.set_location(location);
+
+	kyhttp::HttpClientOption option;
+	option.m_show_request     = FALSE;
+	option.m_reuse_connection = reuse_connection;
+
+	kyhttp::SSLSetting ssl_setting;
+	ssl_setting.m_verify_ssl_certificate  = FALSE;
+	ssl_setting.m_verify_host_certificate = FALSE;
+
+	kyhttp::HttpClientPtr client = std::make_shared<kyhttp::HttpClient>();
+	client->Configunation(option);
+	client->SettingSSL(ssl_setting);
+
+	auto begin = std::chrono::steady_clock::now();
+	for (int i = 0; i < nrequest; i++)
+	{
+		client->Request(kyhttp::GET, uri, nullptr);
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double, std::milli>(end - begin).count() / nrequest;
+}
+
+void reuse_connection_benchmark()
+{
+	const int nrequest = 200;
+	const char* locations[] = { "http://127.0.0.1:8080/", "https://127.0.0.1:8443/" };
+
+	for (auto location : locations)
+	{
+		double new_handle = request_latency_avg(location, FALSE, nrequest);
+		double reuse_handle = request_latency_avg(location, TRUE, nrequest);
+
+		std::cout << location << " : new handle = " << new_handle << " ms/request"
+				  << " | reuse handle = " << reuse_handle << " ms/request" << std::endl;
+	}
+}
+
+void async_request_test()
+{
+	kyhttp::Uri uri;
+	uri.set_location("http://127.0.0.1:8080/");
+
+	kyhttp::HttpClientOption option;
+	option.m_show_request = FALSE;
+
+	kyhttp::AsyncHttpClientPtr client = std::make_shared<kyhttp::AsyncHttpClient>();
+	client->Configunation(option);
+	client->AttachSharePool(kyhttp::HttpSharePool::Global());
+
+	const int nrequest = 500;
+	std::vector<std::future<kyhttp::HttpResponsePtr>> responses;
+
+	auto begin = std::chrono::steady_clock::now();
+	for (int i = 0; i < nrequest; i++)
+	{
+		responses.push_back(client->RequestAsync(kyhttp::GET, uri, nullptr));
+	}
+
+	int nsuccess = 0;
+	for (auto& response : responses)
+	{
+		if (response.get()->GetErrorCode() == kyhttp::KY_HTTP_OK)
+			nsuccess++;
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	std::cout << nsuccess << "/" << nrequest << " requests done in "
+			  << std::chrono::duration<double, std::milli>(end - begin).count() << " ms" << std::endl;
+}
+
+// local h2 stand-in : nghttpd --no-tls 8081 (h2c) | nghttpd 8443 server.key server.crt (h2)
+void http2_multiplex_test(IN const char* location, IN kyhttp::HttpVersion version)
+{
+	kyhttp::Uri uri;
+	uri.set_location(location);
+
+	kyhttp::HttpClientOption option;
+	option.m_show_request = FALSE;
+	option.m_http_version = version;
+	option.m_max_concurrent_streams = 100;
+	option.m_max_host_connections   = 4;
+
+	kyhttp::SSLSetting ssl_setting;
+	ssl_setting.m_verify_ssl_certificate  = FALSE;
+	ssl_setting.m_verify_host_certificate = FALSE;
+
+	kyhttp::AsyncHttpClientPtr client = std::make_shared<kyhttp::AsyncHttpClient>();
+	client->Configunation(option);
+	client->SettingSSL(ssl_setting);
+
+	const int nrequest = 500;
+	std::vector<std::future<kyhttp::HttpResponsePtr>> responses;
+
+	auto begin = std::chrono::steady_clock::now();
+	for (int i = 0; i < nrequest; i++)
+	{
+		responses.push_back(client->RequestAsync(kyhttp::GET, uri, nullptr));
+	}
+
+	long nconnect = 0; double nbytes = 0;
+	for (auto& response : responses)
+	{
+		auto res = response.get();
+		nconnect += res->GetNumConnects();
+		nbytes   += (double)res->Content()->length();
+	}
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+	std::cout << location << " : connections = " << nconnect << ", throughput = "
+			  << kyhttp::convert_bytes_to_text(nbytes / elapsed) << "/sec" << std::endl;
+}
+
+// count allocation and bytes copied of response body (16KB chunk same as curl write callback)
+// mode 0 : grow by chunk (old) | 1 : geometric growth (unknown length) | 2 : reserve Content-Length
+void content_reserve_benchmark()
+{
+	const size_t chunk_size = 16 * 1024;
+	std::vector<char> chunk(chunk_size, 'x');
+
+	const char* mode_name[] = { "grow by chunk", "geometric", "content-length" };
+	size_t body_sizes[] = { 1024, 100 * 1024, 1024 * 1024, 10 * 1024 * 1024, 100 * 1024 * 1024 };
+
+	for (auto body_size : body_sizes)
+	{
+		for (int mode = 0; mode < 3; mode++)
+		{
+			// grow by chunk : copied = O(n^2) -> too slow for big body
+			if (mode == 0 && body_size > 10 * 1024 * 1024)
+			{
+				double nchunk = (double)body_size / chunk_size;
+				std::cout << kyhttp::convert_bytes_to_text((double)body_size) << " [" << mode_name[mode] << "] : alloc ~ " << (size_t)nchunk
+						  << ", copied ~ " << kyhttp::convert_bytes_to_text(nchunk * (double)body_size / 2) << " (estimated)" << std::endl;
+				continue;
+			}
+
+			HttpBuffer buffer;
+			size_t nalloc = 0; double ncopied = 0;
+
+			if (mode == 2)
+			{
+				buffer.reserve(body_size);
+				nalloc++;
+			}
+
+			auto begin = std::chrono::steady_clock::now();
+			for (size_t received = 0; received < body_size; received += chunk_size)
+			{
+				size_t remain = body_size - received;
+				unsigned int nsize = static_cast<unsigned int>(remain < chunk_size ? remain : chunk_size);
+				void* old = buffer.buffer();
+
+				if (mode == 0 && buffer.length() + nsize > buffer.capacity())
+				{
+					buffer.reserve(buffer.length() + nsize);
+				}
+
+				size_t old_length = buffer.length();
+				buffer.append(chunk.data(), nsize);
+
+				if (old != buffer.buffer())
+				{
+					nalloc++;
+					ncopied += (double)old_length;
+				}
+			}
+			double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+			std::cout << kyhttp::convert_bytes_to_text((double)body_size) << " [" << mode_name[mode] << "] : alloc = " << nalloc
+					  << ", copied = " << kyhttp::convert_bytes_to_text(ncopied) << ", time = " << elapsed << " ms" << std::endl;
+		}
+	}
+}
+
+// append cost per byte must be the same for all sizes (linear) | small payload : inline storage
+void buffer_append_benchmark()
+{
+	const size_t chunk_size = 16 * 1024;
+	std::vector<char> chunk(chunk_size, 'x');
+
+	for (size_t body_size = 1024 * 1024; body_size <= 256 * 1024 * 1024; body_size *= 4)
+	{
+		auto begin = std::chrono::steady_clock::now();
+
+		HttpBuffer buffer;
+		for (size_t received = 0; received < body_size; received += chunk_size)
+		{
+			buffer.append(chunk.data(), chunk_size);
+		}
+		double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+		std::cout << kyhttp::convert_bytes_to_text((double)body_size) << " : " << elapsed / 1000000.0 << " ms, "
+				  << elapsed / body_size << " ns/byte" << std::endl;
+	}
+
+	const int nbuffer = 1000000;
+	auto begin = std::chrono::steady_clock::now();
+	size_t total = 0;
+	for (int i = 0; i < nbuffer; i++)
+	{
+		HttpBuffer small;
+		small.append("key=value&id=", 13);
+		small.append(chunk.data(), 32);
+		HttpBuffer moved(std::move(small));
+		total += moved.length();
+	}
+	double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+	std::cout << nbuffer << " small buffers (" << total / nbuffer << " bytes) : " << elapsed << " ms" << std::endl;
+}
+
+// HttpBufferPool : buffers of many sizes created / freed by many threads (hit rate of pool)
+void buffer_pool_benchmark()
+{
+	const int nthread = 8;
+	const int nbuffer = 50000;
+	const size_t sizes[] = { 300, 2 * 1024, 16 * 1024, 64 * 1024, 512 * 1024 };
+
+	std::vector<char> chunk(512 * 1024, 'x');
+	HttpBufferPoolStats before = HttpBufferPool::Global().GetStats();
+
+	auto begin = std::chrono::steady_clock::now();
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < nthread; t++)
+	{
+		threads.push_back(std::thread([&chunk, &sizes, t]()
+		{
+			for (int i = 0; i < nbuffer; i++)
+			{
+				HttpBuffer buffer;
+				buffer.append(chunk.data(), sizes[(i + t) % (sizeof(sizes) / sizeof(sizes[0]))]);
+			}
+		}));
+	}
+
+	for (auto& thread : threads)
+		thread.join();
+
+	double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+	HttpBufferPoolStats after = HttpBufferPool::Global().GetStats();
+
+	unsigned long long alloc_count = after.m_alloc_count - before.m_alloc_count;
+	unsigned long long hit_count   = after.m_hit_count - before.m_hit_count;
+	unsigned long long miss_count  = after.m_miss_count - before.m_miss_count;
+
+	std::cout << nthread << " threads x " << nbuffer << " buffers : " << elapsed << " ms" << std::endl;
+	std::cout << "allocate : " << alloc_count << ", hit : " << hit_count << ", miss : " << miss_count
+			  << " (hit rate " << (alloc_count > 0 ? 100.0 * hit_count / alloc_count : 0.0) << " %)" << std::endl;
+	std::cout << "retained : " << kyhttp::convert_bytes_to_text((double)after.m_retained_bytes) << std::endl;
+}
+
+// startup sequence : send all requests in one batch (order of result same order of request)
+// local stand-in server : python -m http.server 8080 (ksmartapi/v1/... files under its root)
+void startup_batch_test(IN const char* server)
+{
+	const char* paths[] =
+	{
+		"/ksmartapi/v1/user/auth/plcy",
+		"/ksmartapi/v1/config",
+		"/ksmartapi/v1/lib/part/allpart",
+		"/ksmartapi/v1/lib/pkg/allpkg",
+		"/ksmartapi/v1/job/act/list",
+	};
+
+	std::vector<std::string> locations;
+	std::vector<kyhttp::HttpBatchItem> items;
+	for (auto path : paths)
+	{
+		locations.push_back(std::string(server) + path);
+
+		kyhttp::HttpBatchItem item;
+		item.m_method = kyhttp::GET;
+		item.m_uri.set_location(locations.back().c_str());
+		items.push_back(item);
+	}
+
+	kyhttp::HttpBatchOption batch_option;
+	batch_option.m_max_in_flight = 8;
+	batch_option.m_max_per_host  = 4;
+
+	kyhttp::HttpClient client;
+	auto results = client.RequestBatch(items, batch_option);
+
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		std::cout << locations[i] << " : " << results[i].m_error_code << std::endl;
+	}
+}
+
+// header table : lookup by name (case-insensitive), repeated fields
+void response_header_test(IN const char* location)
+{
+	kyhttp::Uri uri;
+	uri.set_location(location);
+
+	kyhttp::HttpClientOption option;
+	option.m_auto_redirect = FALSE; // keep Location
+
+	kyhttp::HttpClientPtr client = std::make_shared<kyhttp::HttpClient>();
+	client->Configunation(option);
+
+	if (client->Request(kyhttp::GET, uri, nullptr) != kyhttp::KY_HTTP_OK)
+		return;
+
+	auto response = client->Response();
+	std::cout << "Location : " << response->GetHeader("location").str() << std::endl;
+
+	for (auto cookie : response->GetHeaders("Set-Cookie"))
+	{
+		std::cout << "Set-Cookie : " << cookie.str() << std::endl;
+	}
+}
+
+// HTTP-date : check parser (random dates, mutated strings) then compare with sscanf_s + mktime
+void http_date_parse_benchmark()
+{
+	const char* weekdays[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+	const char* months[]   = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+	srand(12345);
+
+	// round trip : epoch -> IMF-fixdate / asctime -> epoch
+	int nerror = 0;
+	for (int i = 0; i < 100000; i++)
+	{
+		time_t expected = (time_t)(((long long)rand() * RAND_MAX + rand()) % 4102444800LL); // [1970, 2100)
+		struct tm tm {};
+		gmtime_s(&tm, &expected);
+
+		char imf[64], asc[64];
+		snprintf(imf, sizeof(imf), "%s, %02d %s %04d %02d:%02d:%02d GMT", weekdays[tm.tm_wday], tm.tm_mday,
+				 months[tm.tm_mon], tm.tm_year + 1900, tm.tm_hour, tm.tm_min, tm.tm_sec);
+		snprintf(asc, sizeof(asc), "%s %s %2d %02d:%02d:%02d %04d", weekdays[tm.tm_wday], months[tm.tm_mon],
+				 tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec, tm.tm_year + 1900);
+
+		time_t t1 = 0, t2 = 0;
+		if (!kyhttp::parse_http_date(imf, strlen(imf), t1) || t1 != expected ||
+			!kyhttp::parse_http_date(asc, strlen(asc), t2) || t2 != expected)
+		{
+			if (nerror++ < 5) std::cout << "round trip failed : " << imf << " | " << asc << std::endl;
+		}
+	}
+
+	time_t t850 = 0;
+	const char* rfc850 = "Sunday, 06-Nov-94 08:49:37 GMT";
+	if (!kyhttp::parse_http_date(rfc850, strlen(rfc850), t850) || t850 != 784111777)
+	{
+		nerror++;
+		std::cout << "rfc 850 failed : " << rfc850 << std::endl;
+	}
+
+	// fuzz : mutated / truncated strings must not crash or read out of range
+	const char* seed = "Sun, 06 Nov 1994 08:49:37 GMT";
+	const char  alphabet[] = "0123456789 :,-GMTabcNovSun\t\r\n\xff";
+	int naccepted = 0;
+	for (int i = 0; i < 1000000; i++)
+	{
+		char fuzz[40];
+		size_t nsize = strlen(seed);
+		memcpy(fuzz, seed, nsize);
+
+		int nmutation = 1 + rand() % 4;
+		for (int m = 0; m < nmutation; m++)
+		{
+			fuzz[rand() % nsize] = alphabet[rand() % (sizeof(alphabet) - 1)];
+		}
+		nsize = rand() % 8 == 0 ? rand() % (nsize + 1) : nsize;
+
+		time_t t = 0;
+		naccepted += kyhttp::parse_http_date(fuzz, nsize, t) ? 1 : 0;
+	}
+	std::cout << "check errors : " << nerror << ", fuzz accepted : " << naccepted << " / 1000000" << std::endl;
+
+	// benchmark : same Date of many responses / different dates
+	const int nparse = 1000000;
+	const char* header = "Date: Fri, 25 Nov 2022 10:47:10 GMT";
+
+	auto begin = std::chrono::steady_clock::now();
+	time_t total = 0;
+	for (int i = 0; i < nparse; i++)
+	{
+		struct tm tm {};
+		char strdayofweek[26]{ 0 };
+		char strmonth[26]{ 0 };
+		sscanf_s(header, "Date: %s %d %s %d %d:%d:%d", strdayofweek, 26, &tm.tm_mday, strmonth, 26,
+				 &tm.tm_year, &tm.tm_hour, &tm.tm_min, &tm.tm_sec);
+		for (int m = 0; m < 12; m++)
+		{
+			if (strcmp(months[m], strmonth) == 0)
+				tm.tm_mon = m;
+		}
+		tm.tm_year -= 1900;
+		total += mktime(&tm);
+	}
+	double elapsed_old = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+	begin = std::chrono::steady_clock::now();
+	for (int i = 0; i < nparse; i++)
+	{
+		time_t t = 0;
+		kyhttp::parse_http_date(header + 6, strlen(header + 6), t);
+		total += t;
+	}
+	double elapsed_same = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+	char dates[64][40];
+	for (int i = 0; i < 64; i++)
+	{
+		snprintf(dates[i], sizeof(dates[i]), "Fri, %02d Nov 2022 10:47:%02d GMT", 1 + i % 28, i % 60);
+	}
+
+	begin = std::chrono::steady_clock::now();
+	for (int i = 0; i < nparse; i++)
+	{
+		time_t t = 0;
+		kyhttp::parse_http_date(dates[i & 63], strlen(dates[i & 63]), t);
+		total += t;
+	}
+	double elapsed_diff = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+	std::cout << "sscanf_s + mktime : " << elapsed_old / nparse << " ns/date" << std::endl;
+	std::cout << "parse_http_date (same date) : " << elapsed_same / nparse << " ns/date" << std::endl;
+	std::cout << "parse_http_date (different dates) : " << elapsed_diff / nparse << " ns/date" << std::endl;
+	std::cout << "(checksum " << (long long)total << ")" << std::endl;
+}
+
+// request body compression on a slow link (upload limited) : build with KYHTTP_USE_ZLIB
+void upload_compress_benchmark(IN const char* location, IN const wchar_t* json_file)
+{
+	kyhttp::Uri uri;
+	uri.set_location(location);
+
+	kyhttp::HttpClientOption option;
+	option.m_show_request	  = FALSE;
+	option.m_max_upload_speed = 1024; // 1 MB/s
+
+	// encoders are off by default (KYHTTP_USE_ZLIB)
+	if (!kyhttp::is_content_encoding_supported(kyhttp::KY_HTTP_ENCODING_GZIP))
+	{
+		std::cout << "gzip encoder is not built : define KYHTTP_USE_ZLIB and link zlib." << std::endl;
+		return;
+	}
+
+	const kyhttp::HttpContentEncoding encodings[] = { kyhttp::KY_HTTP_ENCODING_IDENTITY, kyhttp::KY_HTTP_ENCODING_GZIP };
+	for (auto encoding : encodings)
+	{
+		kyhttp::HttpClientPtr  client  = std::make_shared<kyhttp::HttpClient>();
+		kyhttp::HttpRequestPtr request = std::make_shared<kyhttp::HttpRequest>();
+		client->Configunation(option);
+
+		auto content = std::make_shared<kyhttp::HttpRawContent>();
+		content->SetRawType(kyhttp::HttpRawContent::json);
+		content->SetRawData(json_file);
+
+		request->SetContent(content.get());
+		request->SetContentEncoding(encoding);
+
+		auto begin = std::chrono::steady_clock::now();
+		kyhttp::HttpErrorCode err = client->Request(kyhttp::POST, uri, request.get());
+		double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+		std::cout << kyhttp::get_content_encoding_name(request->GetAppliedContentEncoding()) << " : " << err
+				  << ", " << elapsed << " ms" << std::endl;
+	}
+}
+
+
+void cache_revalidation_test(IN const char* location)
+{
+	kyhttp::Uri uri;
+	uri.set_location(location);
+
+	kyhttp::HttpClientOption option;
+	option.m_show_request = FALSE;
+
+	kyhttp::HttpCachePtr cache = std::make_shared<kyhttp::HttpCache>();
+
+	// 1 : miss -> stored / 2 : fresh -> served without request / 3 : forced revalidation -> 304
+	const char* cache_controls[] = { NULL, NULL, "Cache-Control: no-cache" };
+	for (auto cache_control : cache_controls)
+	{
+		kyhttp::HttpClientPtr  client  = std::make_shared<kyhttp::HttpClient>();
+		kyhttp::HttpRequestPtr request = std::make_shared<kyhttp::HttpRequest>();
+		client->Configunation(option);
+		client->AttachCache(cache);
+
+		if (cache_control)
+			request->AddHeader(cache_control);
+
+		kyhttp::HttpErrorCode err = client->Request(kyhttp::GET, uri, request.get());
+		kyhttp::HttpResponsePtr response = client->Response();
+
+		std::cout << err << " : status " << response->GetStatusCode() << ", from cache " << response->IsFromCache()
+				  << ", " << response->Content()->length() << " bytes" << std::endl;
+	}
+
+	kyhttp::HttpCacheStats stats = cache->GetStats();
+	std::cout << "hit " << stats.m_hit_count << ", miss " << stats.m_miss_count
+			  << ", revalidate " << stats.m_revalidate_count << ", not modified " << stats.m_not_modified_count << std::endl;
+}
+
+
+// run twice : second run (new process) loads body from disk, stale entry -> 304
+void disk_cache_restart_test(IN const char* location, IN const wchar_t* directory)
+{
+	kyhttp::Uri uri;
+	uri.set_location(location);
+
+	kyhttp::HttpClientOption option;
+	option.m_show_request = FALSE;
+
+	kyhttp::HttpDiskCachePtr disk = kyhttp::HttpDiskCache::Open(directory);
+	kyhttp::HttpCachePtr cache = std::make_shared<kyhttp::HttpCache>();
+	cache->AttachStore(disk);
+
+	kyhttp::HttpClientPtr client = std::make_shared<kyhttp::HttpClient>();
+	client->Configunation(option);
+	client->AttachCache(cache);
+
+	kyhttp::HttpErrorCode err = client->Request(kyhttp::GET, uri, NULL);
+	kyhttp::HttpResponsePtr response = client->Response();
+
+	kyhttp::HttpCacheStats stats = cache->GetStats();
+	kyhttp::HttpDiskCacheStats disk_stats = disk->GetStats();
+
+	std::cout << err << " : status " << response->GetStatusCode() << ", from cache " << response->IsFromCache()
+			  << ", loaded from disk " << stats.m_store_load_count << ", revalidate " << stats.m_revalidate_count
+			  << ", disk entries " << disk_stats.m_entry_count << std::endl;
+}
+
+
+// Vary response (Vary: Accept-Encoding) : variant found again after the store is reopened
+void disk_cache_vary_restart_test(IN const char* location, IN const wchar_t* directory)
+{
+	kyhttp::Uri uri;
+	uri.set_location(location);
+
+	kyhttp::HttpClientOption option;
+	option.m_show_request = FALSE;
+
+	// 1 : downloaded and saved / 2 : new cache and store (restart) -> loaded from disk
+	for (int run = 0; run < 2; run++)
+	{
+		kyhttp::HttpDiskCachePtr disk = kyhttp::HttpDiskCache::Open(directory);
+		kyhttp::HttpCachePtr cache = std::make_shared<kyhttp::HttpCache>();
+		cache->AttachStore(disk);
+
+		kyhttp::HttpClientPtr  client  = std::make_shared<kyhttp::HttpClient>();
+		kyhttp::HttpRequestPtr request = std::make_shared<kyhttp::HttpRequest>();
+		client->Configunation(option);
+		client->AttachCache(cache);
+		request->AddHeader("Accept-Encoding: gzip");
+
+		kyhttp::HttpErrorCode err = client->Request(kyhttp::GET, uri, request.get());
+		kyhttp::HttpResponsePtr response = client->Response();
+
+		kyhttp::HttpCacheStats stats = cache->GetStats();
+		std::cout << "run " << run << " : " << err << ", status " << response->GetStatusCode()
+				  << ", from cache " << response->IsFromCache() << ", loaded from disk " << stats.m_store_load_count
+				  << ", disk entries " << disk->GetStats().m_entry_count << std::endl;
+	}
+}
+
+
+void retry_policy_test(IN const char* location)
+{
+	kyhttp::Uri uri;
+	uri.set_location(location);
+
+	kyhttp::HttpClientOption option;
+	option.m_show_request = FALSE;
+
+	// 3 retries, delay 100ms .. 5s, retries <= 10% of requests by host
+	kyhttp::HttpRetryPolicyPtr retry_policy = std::make_shared<kyhttp::HttpRetryPolicy>(3, 100, 5000);
+	retry_policy->SetRetryBudget(0.1);
+
+	kyhttp::HttpClientPtr client = std::make_shared<kyhttp::HttpClient>();
+	client->Configunation(option);
+	client->AttachRetryPolicy(retry_policy);
+
+	kyhttp::HttpErrorCode err = client->Request(kyhttp::GET, uri, NULL);
+	kyhttp::HttpResponsePtr response = client->Response();
+
+	std::cout << err << " : status " << response->GetStatusCode() << ", retry " << response->GetRetryCount()
+			  << ", wait " << response->GetRetryDelay() << " ms" << std::endl;
+}
+
+// tail latency with / without hedged GET (server : some responses are late)
+void hedged_request_benchmark(IN const char* location)
+{
+	kyhttp::Uri uri;
+	uri.set_location(location);
+
+	kyhttp::HttpClientOption option;
+	option.m_show_request = FALSE;
+
+	// 0 : no hedge | 1 : fixed delay 100ms | 2 : adaptive delay (p95 of first byte)
+	const char* mode_name[] = { "no hedge", "fixed   ", "adaptive" };
+
+	for (int mode = 0; mode < 3; mode++)
+	{
+		// hedges <= 10% of requests
+		kyhttp::HttpHedgePolicyPtr hedge_policy = std::make_shared<kyhttp::HttpHedgePolicy>(mode == 1 ? 100 : 0, 0.1);
+
+		kyhttp::AsyncHttpClientPtr client = std::make_shared<kyhttp::AsyncHttpClient>();
+		client->Configunation(option);
+		client->AttachSharePool(kyhttp::HttpSharePool::Global());
+		if (mode > 0)
+			client->AttachHedgePolicy(hedge_policy);
+
+		const int nwave = 20, nrequest = 20;
+		std::vector<double> latencies;
+
+		for (int wave = 0; wave < nwave; wave++)
+		{
+			std::vector<std::promise<double>> done(nrequest);
+			auto begin = std::chrono::steady_clock::now();
+
+			for (int i = 0; i < nrequest; i++)
+			{
+				std::promise<double>* promise = &done[i];
+				client->RequestAsync(kyhttp::GET, uri, nullptr, [promise, begin](kyhttp::HttpErrorCode, kyhttp::HttpResponsePtr)
+				{
+					promise->set_value(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count());
+				});
+			}
+
+			for (auto& promise : done)
+			{
+				latencies.push_back(promise.get_future().get());
+			}
+		}
+
+		std::sort(latencies.begin(), latencies.end());
+		std::cout << mode_name[mode] << " : p50 = " << latencies[latencies.size() / 2]
+				  << " ms, p99 = " << latencies[latencies.size() * 99 / 100] << " ms";
+
+		if (mode > 0)
+		{
+			kyhttp::HttpHedgeStats stats = hedge_policy->GetStats();
+			std::cout << ", hedges = " << stats.m_hedge_count << ", won = " << stats.m_hedge_won_count
+					  << ", denied = " << stats.m_rate_denied_count;
+		}
+		std::cout << std::endl;
+	}
+}
+
+// server down : first requests wait connect timeout, next ones fail fast until probe succeeds
+void circuit_breaker_test(IN const char* location)
+{
+	kyhttp::Uri uri;
+	uri.set_location(location);
+
+	kyhttp::HttpClientOption option;
+	option.m_show_request	= FALSE;
+	option.m_connect_timout = 2000;
+
+	kyhttp::HttpCircuitBreakerPtr circuit_breaker = kyhttp::HttpCircuitBreaker::Global();
+
+	kyhttp::HttpClientPtr client = std::make_shared<kyhttp::HttpClient>();
+	client->Configunation(option);
+	client->AttachCircuitBreaker(circuit_breaker);
+
+	for (int i = 0; i < 20; i++)
+	{
+		auto begin = std::chrono::steady_clock::now();
+		kyhttp::HttpErrorCode err = client->Request(kyhttp::GET, uri, NULL);
+
+		std::cout << i << " : " << err << " in " << std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count()
+				  << " us, circuit " << circuit_breaker->GetState(uri.get_origin()) << std::endl;
+	}
+
+	kyhttp::HttpCircuitStats stats = circuit_breaker->GetStats();
+	std::cout << "open = " << stats.m_open_count << ", rejected = " << stats.m_reject_count << ", probe = " << stats.m_probe_count << std::endl;
+}
+
+// bulk downloads (LOW) + API calls (HIGH) under one process limit : API calls keep most of the rate
+void bandwidth_governor_test(IN const char* bulk_location, IN const char* api_location)
+{
+	kyhttp::Uri bulk_uri, api_uri;
+	bulk_uri.set_location(bulk_location);
+	api_uri.set_location(api_location);
+
+	kyhttp::HttpBandwidthGovernorPtr governor = kyhttp::HttpBandwidthGovernor::Global();
+	governor->SetLimit(4096, 0); // 4 MB/s download for all clients
+
+	std::vector<std::thread> bulk_threads;
+	for (int i = 0; i < 4; i++)
+	{
+		bulk_threads.emplace_back([&bulk_uri, governor]()
+		{
+			kyhttp::HttpClientOption option;
+			option.m_show_request		= FALSE;
+			option.m_bandwidth_priority = kyhttp::KY_HTTP_PRIORITY_LOW;
+
+			kyhttp::HttpClientPtr client = std::make_shared<kyhttp::HttpClient>();
+			client->Configunation(option);
+			client->AttachBandwidthGovernor(governor);
+			client->Request(kyhttp::GET, bulk_uri, NULL);
+		});
+	}
+
+	kyhttp::HttpClientOption option;
+	option.m_show_request		= FALSE;
+	option.m_bandwidth_priority = kyhttp::KY_HTTP_PRIORITY_HIGH;
+
+	kyhttp::HttpClientPtr client = std::make_shared<kyhttp::HttpClient>();
+	client->Configunation(option);
+	client->AttachBandwidthGovernor(governor);
+
+	for (int i = 0; i < 5; i++)
+	{
+		auto begin = std::chrono::steady_clock::now();
+		kyhttp::HttpErrorCode err = client->Request(kyhttp::GET, api_uri, NULL);
+
+		std::cout << "api " << i << " : " << err << " in "
+				  << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count() << " ms" << std::endl;
+	}
+
+	for (auto& thread : bulk_threads)
+	{
+		thread.join();
+	}
+
+	kyhttp::HttpBandwidthStats stats = governor->GetStats();
+	std::cout << "download = " << stats.m_download_bytes << " bytes, throttle = " << stats.m_throttle_count
+			  << " (" << stats.m_throttle_time << " ms)" << std::endl;
+}
+
+
+// coroutine of demo : starts at once, frame freed when it returns
+struct coroutine_task
+{
+	struct promise_type
+	{
+		coroutine_task get_return_object() { return coroutine_task(); }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+};
+
+// GET then POST in sequence without blocking a thread (resumed on driver thread)
+coroutine_task coroutine_request(IN kyhttp::AsyncHttpClientPtr client, IN kyhttp::Uri uri, IN std::promise<void>* done)
+{
+	kyhttp::HttpResponsePtr response = co_await client->GetAsync(uri);
+	std::cout << "GET  : " << response->GetErrorCode() << ", status " << response->GetStatusCode() << std::endl;
+
+	auto content = std::make_shared<kyhttp::HttpUrlEncodedContent>();
+	content->AddKeyValue("kp", "coroutine");
+
+	kyhttp::HttpRequestPtr request = std::make_shared<kyhttp::HttpRequest>();
+	request->SetContent(content.get());
+
+	response = co_await client->PostAsync(uri, request);
+	std::cout << "POST : " << response->GetErrorCode() << ", status " << response->GetStatusCode() << std::endl;
+
+	done->set_value();
+}
+
+void coroutine_request_test()
+{
+	kyhttp::Uri uri;
+	uri.set_location("http://127.0.0.1:8080/");
+
+	kyhttp::HttpClientOption option;
+	option.m_show_request = FALSE;
+
+	kyhttp::AsyncHttpClientPtr client = std::make_shared<kyhttp::AsyncHttpClient>();
+	client->Configunation(option);
+
+	std::promise<void> done;
+	coroutine_request(client, uri, &done);
+	done.get_future().wait();
+}
 
 int main()
 {
@@ -245,6 +1039,57 @@ int main()
 
 	//9. upload file
 	//upload_file_multipart();
+
+	//10. reuse connection benchmark
+	//reuse_connection_benchmark();
+
+	//11. async request
+	//async_request_test();
+
+	//12. HTTP/2 multiplex vs HTTP/1.1
+	//http2_multiplex_test("http://127.0.0.1:8081/", kyhttp::KY_HTTP_VERSION_1_1);
+	//http2_multiplex_test("http://127.0.0.1:8081/", kyhttp::KY_HTTP_VERSION_2_PRIOR_KNOWLEDGE);
+
+	//13. startup batch
+	//startup_batch_test("http://127.0.0.1:8080");
+
+	//14. response body allocation
+	//content_reserve_benchmark();
+
+	//15. HttpBuffer append
+	//buffer_append_benchmark();
+	//buffer_pool_benchmark();
+
+	//16. HTTP-date parse
+	//http_date_parse_benchmark();
+
+	//17. request body compression
+	//upload_compress_benchmark("http://127.0.0.1:8092/", L"ksmart_api/request/login.json");
+
+	//18. response cache (ETag / Last-Modified)
+	//cache_revalidation_test("http://127.0.0.1:8093/fresh");
+
+	//19. persistent cache (warm restart)
+	//disk_cache_restart_test("http://127.0.0.1:8093/fresh", L"kyhttp_cache");
+	//disk_cache_vary_restart_test("http://127.0.0.1:8093/vary", L"kyhttp_cache");
+
+	//20. retry policy (503 + Retry-After)
+	//retry_policy_test("http://127.0.0.1:8094/flaky?n=2&ra=1");
+
+	//21. hedged GET (tail latency)
+	//hedged_request_benchmark("http://127.0.0.1:8095/slow?p=0.02");
+
+	//22. circuit breaker (server down)
+	//circuit_breaker_test("http://10.255.255.1/ksmart_api");
+
+	//23. bandwidth governor (priority share)
+	//bandwidth_governor_test("http://127.0.0.1:8080/r4m.bin", "http://127.0.0.1:8080/r512k.bin");
+
+	//24. response header lookup
+	//response_header_test("https://youtube.com");
+
+	//25. co_await GetAsync / PostAsync
+	//coroutine_request_test();
 	getchar();
 
 	return 1;